@@ -0,0 +1,329 @@
+// Tiny micro-benchmark harness shared by the per-version/*/*/bench.cpp files.
+// Kept to C++11 so the C++11 examples can be measured with -std=c++11 too.
+//
+// Each benchmark is a callable taking an iteration count; the harness picks
+// a count that makes one repetition last at least --min-time-ms, runs
+// --warmup untimed repetitions and --reps timed ones, and reports
+// min/median/mean/stddev of ns per iteration. Where the kernel allows it
+// (perf_event_paranoid <= 2, or CAP_PERFMON) it also reads cycles,
+// instructions, cache misses and branch misses per iteration.
+//
+// Flags: --reps=N --warmup=N --min-time-ms=X --filter=substring --json=path
+#ifndef CPPAWEEK_BENCH_HPP
+#define CPPAWEEK_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+// Keeps the compiler from optimizing away a value or the stores behind it.
+template<typename T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// One-shot wall-clock timers for the example programs that print their own
+// comparison instead of going through Runner.
+template<typename F>
+double measure_ms(F&& f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Mean wall-clock time of one call over `reps` calls.
+template<typename F>
+double measure_ns(F&& f, int reps) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(int i = 0; i < reps; i++) {
+        f();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / reps;
+}
+
+// Hardware counters, read as one group so they cover the same interval.
+class Counters {
+public:
+    enum { Cycles, Instructions, CacheMisses, BranchMisses, Count };
+
+    Counters() {
+#if defined(__linux__)
+        const std::uint64_t configs[Count] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+        };
+        for(int i = 0; i < Count; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = i == 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            fds_[i] = int(syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0));
+            if(fds_[i] < 0) {
+                close_all();
+                return;
+            }
+        }
+        available_ = true;
+#endif
+    }
+    ~Counters() { close_all(); }
+
+    bool available() const { return available_; }
+
+    void start() {
+#if defined(__linux__)
+        if(!available_) return;
+        ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    // Fills `out` with the counts since start(); false if unavailable.
+    bool stop(std::uint64_t (&out)[Count]) {
+#if defined(__linux__)
+        if(!available_) return false;
+        ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        std::uint64_t buf[1 + Count];
+        if(read(fds_[0], buf, sizeof(buf)) != ssize_t(sizeof(buf))) return false;
+        for(int i = 0; i < Count; i++) out[i] = buf[1 + i];
+        return true;
+#else
+        (void) out;
+        return false;
+#endif
+    }
+
+    static const char* name(int i) {
+        static const char* names[Count] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+        return names[i];
+    }
+
+private:
+    void close_all() {
+#if defined(__linux__)
+        for(int i = 0; i < Count; i++) {
+            if(fds_[i] >= 0) ::close(fds_[i]);
+            fds_[i] = -1;
+        }
+#endif
+        available_ = false;
+    }
+
+    int fds_[Count] = {-1, -1, -1, -1};
+    bool available_ = false;
+};
+
+struct Summary {
+    double min, median, mean, stddev;
+};
+
+inline Summary summarize(std::vector<double> v) {
+    Summary s = {0, 0, 0, 0};
+    if(v.empty()) return s;
+    std::sort(v.begin(), v.end());
+    s.min = v.front();
+    s.median = v.size() % 2 ? v[v.size() / 2] : (v[v.size() / 2 - 1] + v[v.size() / 2]) / 2;
+    for(std::size_t i = 0; i < v.size(); i++) s.mean += v[i];
+    s.mean /= v.size();
+    for(std::size_t i = 0; i < v.size(); i++) s.stddev += (v[i] - s.mean) * (v[i] - s.mean);
+    s.stddev = v.size() > 1 ? std::sqrt(s.stddev / (v.size() - 1)) : 0;
+    return s;
+}
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations;
+    std::size_t reps;
+    Summary ns_per_iter;
+    bool has_counters;
+    double counters[Counters::Count]; // per iteration, median over reps
+};
+
+class Runner {
+public:
+    // `suite` names the example, e.g. "20/span".
+    Runner(int argc, char** argv, const char* suite) : suite_(suite) {
+        for(int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if(!flag(arg, "--reps=", reps_) && !flag(arg, "--warmup=", warmup_) &&
+               !flag(arg, "--min-time-ms=", min_time_ms_) && !flag(arg, "--filter=", filter_) &&
+               !flag(arg, "--json=", json_path_)) {
+                std::cerr << "unknown argument: " << arg << std::endl;
+                std::exit(2);
+            }
+        }
+        reps_ = std::max(1, reps_);
+        std::printf("%s (C++%ld, %s)%s\n", suite_.c_str(), __cplusplus / 100 % 100, compiler(),
+            counters_.available() ? "" : " -- hardware counters unavailable");
+        std::printf("%-40s %12s %12s %12s %8s %10s %10s\n", "benchmark", "min ns", "median ns",
+            "mean ns", "cv %", "IPC", "br-miss");
+    }
+
+    // `f(iters)` must do `iters` iterations of the measured work.
+    template<typename F>
+    void run(const std::string& name, F f) {
+        if(!filter_.empty() && name.find(filter_) == std::string::npos) return;
+
+        std::uint64_t iters = 1;
+        for(;;) { // calibrate: grow until one repetition is long enough
+            double ms = time_ns(f, iters) / 1e6;
+            if(ms >= min_time_ms_ || iters >= (std::uint64_t(1) << 40)) break;
+            double factor = ms > 0 ? std::min(10.0, 1.4 * min_time_ms_ / ms) : 10.0;
+            iters = std::max(iters + 1, std::uint64_t(iters * factor));
+        }
+        for(int i = 0; i < warmup_; i++) time_ns(f, iters);
+
+        Result r;
+        r.name = name;
+        r.iterations = iters;
+        r.reps = reps_;
+        r.has_counters = counters_.available();
+        std::vector<double> ns;
+        std::vector<double> per_counter[Counters::Count];
+        for(int i = 0; i < reps_; i++) {
+            std::uint64_t c[Counters::Count];
+            counters_.start();
+            ns.push_back(time_ns(f, iters) / iters);
+            if(counters_.stop(c)) {
+                for(int k = 0; k < Counters::Count; k++) per_counter[k].push_back(double(c[k]) / iters);
+            } else {
+                r.has_counters = false;
+            }
+        }
+        r.ns_per_iter = summarize(ns);
+        for(int k = 0; k < Counters::Count; k++) {
+            r.counters[k] = r.has_counters ? summarize(per_counter[k]).median : 0;
+        }
+        print(r);
+        results_.push_back(r);
+    }
+
+    // Writes the JSON report if asked to; use as `return runner.finish();`.
+    int finish() {
+        if(json_path_.empty()) return 0;
+        std::ofstream out(json_path_.c_str());
+        out << json();
+        if(!out) {
+            std::cerr << "could not write " << json_path_ << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    std::string json() const {
+        std::ostringstream o;
+        o.precision(10);
+        o << "{\n  \"suite\": \"" << suite_ << "\",\n  \"cplusplus\": " << __cplusplus
+          << ",\n  \"compiler\": \"" << compiler() << "\",\n  \"benchmarks\": [";
+        for(std::size_t i = 0; i < results_.size(); i++) {
+            const Result& r = results_[i];
+            o << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+              << ", \"reps\": " << r.reps << ", \"ns_per_iter\": {\"min\": " << r.ns_per_iter.min
+              << ", \"median\": " << r.ns_per_iter.median << ", \"mean\": " << r.ns_per_iter.mean
+              << ", \"stddev\": " << r.ns_per_iter.stddev << "}";
+            if(r.has_counters) {
+                o << ", \"counters_per_iter\": {";
+                for(int k = 0; k < Counters::Count; k++) {
+                    o << (k ? ", " : "") << "\"" << Counters::name(k) << "\": " << r.counters[k];
+                }
+                o << "}";
+            }
+            o << "}";
+        }
+        o << "\n  ]\n}\n";
+        return o.str();
+    }
+
+private:
+    template<typename F>
+    static double time_ns(F& f, std::uint64_t iters) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f(iters);
+        clobber_memory();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    void print(const Result& r) const {
+        double cv = r.ns_per_iter.mean > 0 ? 100 * r.ns_per_iter.stddev / r.ns_per_iter.mean : 0;
+        std::printf("%-40s %12.2f %12.2f %12.2f %8.2f", r.name.c_str(), r.ns_per_iter.min,
+            r.ns_per_iter.median, r.ns_per_iter.mean, cv);
+        if(r.has_counters && r.counters[Counters::Cycles] > 0) {
+            std::printf(" %10.2f %10.3f\n", r.counters[Counters::Instructions] / r.counters[Counters::Cycles],
+                r.counters[Counters::BranchMisses]);
+        } else {
+            std::printf(" %10s %10s\n", "-", "-");
+        }
+    }
+
+    static bool flag(const std::string& arg, const char* prefix, int& out) {
+        std::string value;
+        if(!flag(arg, prefix, value)) return false;
+        out = std::max(0, std::atoi(value.c_str()));
+        return true;
+    }
+    static bool flag(const std::string& arg, const char* prefix, double& out) {
+        std::string value;
+        if(!flag(arg, prefix, value)) return false;
+        out = std::atof(value.c_str());
+        return true;
+    }
+    static bool flag(const std::string& arg, const char* prefix, std::string& out) {
+        std::size_t n = std::strlen(prefix);
+        if(arg.compare(0, n, prefix) != 0) return false;
+        out = arg.substr(n);
+        return true;
+    }
+
+    static const char* compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#else
+        return "unknown";
+#endif
+    }
+
+    std::string suite_;
+    int reps_ = 15;
+    int warmup_ = 3;
+    double min_time_ms_ = 20;
+    std::string filter_;
+    std::string json_path_;
+    Counters counters_;
+    std::vector<Result> results_;
+};
+
+} // namespace bench
+
+#endif
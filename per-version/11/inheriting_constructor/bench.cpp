@@ -0,0 +1,65 @@
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+
+// The hierarchy from ex.cpp without the printing: construction through an
+// inherited constructor vs. an own one, and the virtual dispatch.
+class A {
+public:
+    A(int a = 2) : x_{a} {}
+    A(double d) : x_{int(d)} {}
+    virtual ~A() {}
+
+    virtual int value() const { return x_; }
+protected:
+    int x_;
+};
+
+class B : public A {
+public:
+    using A::A; // inheriting constructors from A
+
+    B(double d) : A{d}, y_{d + 1} {}
+
+    virtual int value() const override { return x_ + int(y_); }
+protected:
+    double y_ = 0;
+};
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "11/inheriting_constructor");
+
+    runner.run("construct/A(int)", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            A a(static_cast<int>(i));
+            bench::do_not_optimize(a);
+        }
+    });
+    runner.run("construct/B(int) inherited", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            B b(static_cast<int>(i));
+            bench::do_not_optimize(b);
+        }
+    });
+    runner.run("construct/B(double) own", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            B b(static_cast<double>(i));
+            bench::do_not_optimize(b);
+        }
+    });
+
+    std::vector<std::unique_ptr<A>> objects;
+    for(int i = 0; i < 1024; i++) {
+        if(i % 3 == 0) objects.emplace_back(new A(i));
+        else objects.emplace_back(new B(i));
+    }
+    runner.run("virtual/value, mixed A and B", [&](std::uint64_t n) {
+        int sum = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            sum += objects[i % objects.size()]->value();
+        }
+        bench::do_not_optimize(sum);
+    });
+    return runner.finish();
+}
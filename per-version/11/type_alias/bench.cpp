@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+template<typename Item, typename ItemTransformed,
+template <typename> class Container>
+using Mapper = std::function<Container<ItemTransformed>
+    (Container<Item>, std::function<Item(ItemTransformed)>)
+>;
+
+template<typename T>
+using Vector = std::vector<T>; // std::vector itself has two template parameters in C++11
+
+// Mapper from ex.cpp (a std::function taking the container by value and a
+// std::function per element) against a plain std::transform.
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "11/type_alias");
+
+    Mapper<char, int, Vector> const mapper =
+    [](std::vector<char> v, std::function<char(int)> f) {
+        std::vector<int> res;
+        res.reserve(v.size());
+        std::transform(v.begin(), v.end(),
+            std::back_inserter(res), f);
+        return res;
+    };
+
+    for(std::size_t size : {16, 1024, 65536}) {
+        std::vector<char> vc(size);
+        for(std::size_t i = 0; i < size; i++) vc[i] = char('a' + i % 26);
+        std::string suffix = "/" + std::to_string(size);
+
+        runner.run("Mapper" + suffix, [&](std::uint64_t n) {
+            for(std::uint64_t i = 0; i < n; i++) {
+                auto vi = mapper(vc, [](char c) { return c - 'a'; });
+                bench::do_not_optimize(vi.data());
+            }
+        });
+        runner.run("std::transform" + suffix, [&](std::uint64_t n) {
+            for(std::uint64_t i = 0; i < n; i++) {
+                std::vector<int> vi(vc.size());
+                std::transform(vc.begin(), vc.end(), vi.begin(), [](char c) { return c - 'a'; });
+                bench::do_not_optimize(vi.data());
+            }
+        });
+    }
+    return runner.finish();
+}
@@ -0,0 +1,43 @@
+#include "bench.hpp"
+
+// MetricDistance from ex.cpp, without the printing in _km. The literal
+// operators are resolved at compile time, so the sums should cost exactly
+// as much as adding plain doubles.
+class MetricDistance {
+public:
+    MetricDistance(double x) : x_(x) {}
+
+    MetricDistance operator+ (MetricDistance const& md) {
+         return MetricDistance(x_ + md.x_);
+    }
+
+    double x_;
+};
+
+MetricDistance operator"" _km(long double x) {
+    return MetricDistance(double(x * 1000));
+}
+
+MetricDistance operator"" _m(unsigned long long int x) {
+    return MetricDistance(double(x));
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "11/user_defined_literals");
+
+    runner.run("MetricDistance += 4.1_km + 4_m", [](std::uint64_t n) {
+        MetricDistance acc = 0_m;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc = acc + (4.1_km + 4_m);
+            bench::do_not_optimize(acc.x_);
+        }
+    });
+    runner.run("double += 4100.0 + 4.0", [](std::uint64_t n) {
+        double acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc = acc + (4100.0 + 4.0);
+            bench::do_not_optimize(acc);
+        }
+    });
+    return runner.finish();
+}
@@ -0,0 +1,30 @@
+#include "bench.hpp"
+
+// Binary literals and digit separators are purely lexical; this only
+// confirms that masking with 0b1011 costs the same as masking with 11.
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "14/binary_literal");
+
+    runner.run("mask/0b1011", [](std::uint64_t n) {
+        unsigned acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc += unsigned(i) & 0b1011;
+            bench::do_not_optimize(acc);
+        }
+    });
+    runner.run("mask/11", [](std::uint64_t n) {
+        unsigned acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc += unsigned(i) & 11;
+            bench::do_not_optimize(acc);
+        }
+    });
+    runner.run("add/100'250'113", [](std::uint64_t n) {
+        long long acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc += 100'250'113;
+            bench::do_not_optimize(acc);
+        }
+    });
+    return runner.finish();
+}
@@ -0,0 +1,54 @@
+#include <functional>
+
+#include "bench.hpp"
+
+// alambda/tlambda from ex.cpp minus the printing: a generic lambda is just a
+// class with a templated operator(), so calling it directly should be as
+// cheap as a hand-written function; going through std::function isn't.
+int add_one(int a, int b) { return a + b + 1; }
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "14/generic_lambda");
+
+    auto alambda = [](auto a, int b) {
+        return a + b + 1;
+    };
+    runner.run("generic lambda", [&](std::uint64_t n) {
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc = alambda(acc, int(i));
+            bench::do_not_optimize(acc);
+        }
+    });
+
+#if __cplusplus >= 202002L
+    auto tlambda = []<typename T>(T a, int b) {
+        return a + b + 1;
+    };
+    runner.run("template lambda", [&](std::uint64_t n) {
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc = tlambda(acc, int(i));
+            bench::do_not_optimize(acc);
+        }
+    });
+#endif
+
+    runner.run("plain function", [&](std::uint64_t n) {
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc = add_one(acc, int(i));
+            bench::do_not_optimize(acc);
+        }
+    });
+
+    std::function<int(int, int)> f = alambda;
+    runner.run("std::function of generic lambda", [&](std::uint64_t n) {
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc = f(acc, int(i));
+            bench::do_not_optimize(acc);
+        }
+    });
+    return runner.finish();
+}
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "bench.hpp"
+
+// Push-based lazy pipeline. Each stage only says what to do with a single
+// element and then hands it to the next one; `stage | stage | ...` plus a
+// terminal nests them into one object, so the whole thing inlines into one loop
+// with no intermediate containers. Stage functions are plain generic or
+// template lambdas, like `alambda`/`tlambda` in ex.cpp.
+namespace lazy {
+
+template<typename F>
+struct Map {
+    F f;
+    static constexpr bool splittable = true;
+    template<typename Next>
+    struct Bound {
+        F f;
+        Next next;
+        bool operator() (auto&& x) { return next(f(x)); }
+        void finish() { next.finish(); }
+    };
+    template<typename Next>
+    auto bind(Next next) const { return Bound<Next>{f, next}; }
+};
+
+template<typename P>
+struct Filter {
+    P p;
+    static constexpr bool splittable = true;
+    template<typename Next>
+    struct Bound {
+        P p;
+        Next next;
+        bool operator() (auto&& x) { return p(x) ? next(x) : true; }
+        void finish() { next.finish(); }
+    };
+    template<typename Next>
+    auto bind(Next next) const { return Bound<Next>{p, next}; }
+};
+
+struct Take {
+    size_t n;
+    static constexpr bool splittable = false; // depends on global position
+    template<typename Next>
+    struct Bound {
+        size_t n;
+        Next next;
+        size_t seen = 0;
+        bool operator() (auto&& x) {
+            if(seen >= n) return false;
+            ++seen;
+            return next(x) && seen < n;
+        }
+        void finish() { next.finish(); }
+    };
+    template<typename Next>
+    auto bind(Next next) const { return Bound<Next>{n, next}; }
+};
+
+// Groups K consecutive elements into a std::array, so it still needs no
+// allocation; a trailing partial chunk is passed as std::span on finish().
+template<typename T, size_t K>
+struct Chunk {
+    static constexpr bool splittable = false;
+    template<typename Next>
+    struct Bound {
+        Next next;
+        std::array<T, K> buf{};
+        size_t used = 0;
+        bool operator() (auto&& x) {
+            buf[used++] = x;
+            if(used < K) return true;
+            used = 0;
+            return next(std::span<const T>(buf));
+        }
+        void finish() {
+            if(used > 0) next(std::span<const T>(buf.data(), used));
+            next.finish();
+        }
+    };
+    template<typename Next>
+    auto bind(Next next) const { return Bound<Next>{next}; }
+};
+
+template<typename F> Map<F> map(F f) { return {f}; }
+template<typename P> Filter<P> filter(P p) { return {p}; }
+inline Take take(size_t n) { return {n}; }
+template<typename T, size_t K> Chunk<T, K> chunk() { return {}; }
+
+// Sinks are the innermost stage.
+template<typename T>
+struct Into { // writes into a preallocated buffer, stops when it's full
+    T* out;
+    size_t cap;
+    size_t* written;
+    bool operator() (auto&& x) {
+        out[(*written)++] = x;
+        return *written < cap;
+    }
+    void finish() {}
+};
+
+// Starts from the first element it sees, so the caller's init isn't needed
+// (and can't be counted twice) when several of these are combined.
+template<typename T, typename Op>
+struct Reduce {
+    std::optional<T>* acc;
+    Op op;
+    bool operator() (auto&& x) {
+        *acc = *acc ? op(**acc, x) : T(x);
+        return true;
+    }
+    void finish() {}
+};
+
+template<typename... Stages>
+struct Pipeline {
+    using is_pipeline = void;
+    std::tuple<Stages...> stages;
+    static constexpr bool splittable = (Stages::splittable && ...);
+
+    template<typename Sink>
+    auto bind(Sink sink) const {
+        return std::apply([&](const auto&... s) { return bind_rec(sink, s...); }, stages);
+    }
+
+private:
+    template<typename Sink>
+    static auto bind_rec(Sink sink) { return sink; }
+    template<typename Sink, typename First, typename... Rest>
+    static auto bind_rec(Sink sink, const First& first, const Rest&... rest) {
+        return first.bind(bind_rec(sink, rest...));
+    }
+};
+
+template<typename Stage>
+concept IsStage = requires { Stage::splittable; } && !requires { typename Stage::is_pipeline; };
+
+template<IsStage A, IsStage B>
+Pipeline<A, B> operator| (A a, B b) { return {{a, b}}; }
+
+template<typename... S, IsStage B>
+Pipeline<S..., B> operator| (Pipeline<S...> p, B b) {
+    return {std::tuple_cat(p.stages, std::tuple<B>{b})};
+}
+
+template<typename It, typename Fused>
+void drive(It first, It last, Fused& fused) {
+    for( ; first != last; ++first) {
+        if(!fused(*first)) break;
+    }
+    fused.finish();
+}
+
+// Terminal: runs everything in one loop, returns how many elements landed in `out`.
+template<typename R, typename P, typename T>
+size_t into(const R& in, const P& pipeline, std::span<T> out) {
+    size_t written = 0;
+    if(out.empty()) return 0;
+    auto fused = pipeline.bind(Into<T>{out.data(), out.size(), &written});
+    drive(std::begin(in), std::end(in), fused);
+    return written;
+}
+
+// Parallel terminal: every thread runs its own copy of the fused loop over
+// a slice of the input and the partial results are folded into `init` at the
+// end, so `init` is used exactly once. Only for pipelines where no stage
+// depends on the global position.
+template<typename R, typename P, typename T, typename Op>
+requires P::splittable
+T par_reduce(const R& in, const P& pipeline, T init, Op op,
+             unsigned threads = std::thread::hardware_concurrency()) {
+    threads = std::max(1u, threads);
+    std::vector<std::optional<T>> partial(threads);
+    std::vector<std::thread> workers;
+    size_t n = std::size(in);
+    for(unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            std::optional<T> acc;
+            auto fused = pipeline.bind(Reduce<T, Op>{&acc, op});
+            auto b = std::begin(in) + n * t / threads;
+            auto e = std::begin(in) + n * (t + 1) / threads;
+            drive(b, e, fused);
+            partial[t] = acc;
+        });
+    }
+    for(auto& w : workers) w.join();
+    for(auto& p : partial) {
+        if(p) init = op(init, *p);
+    }
+    return init;
+}
+
+} // namespace lazy
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+    std::vector<int> in(n);
+    std::iota(in.begin(), in.end(), 0);
+
+    auto triple = [](auto x) { return x * 3; };
+    auto odd = []<typename T>(T x) { return x % 2 == T(1); };
+    auto plus_one = [](auto x) { return x + 1; };
+    size_t limit = n / 4;
+
+    auto pipeline = lazy::map(triple) | lazy::filter(odd) | lazy::map(plus_one) | lazy::take(limit);
+    std::vector<int> out(limit);
+
+    size_t got = 0;
+    double fused = bench::measure_ms([&] { got = lazy::into(in, pipeline, std::span<int>(out)); });
+    long long check_fused = std::accumulate(out.begin(), out.begin() + got, 0LL);
+
+    std::vector<int> out2;
+    double chained = bench::measure_ms([&] {
+        std::vector<int> s1(n), s2, s3;
+        std::transform(in.begin(), in.end(), s1.begin(), triple);
+        std::copy_if(s1.begin(), s1.end(), std::back_inserter(s2), odd);
+        s3.resize(s2.size());
+        std::transform(s2.begin(), s2.end(), s3.begin(), plus_one);
+        out2.assign(s3.begin(), s3.begin() + std::min(limit, s3.size()));
+    });
+    long long check_chained = std::accumulate(out2.begin(), out2.end(), 0LL);
+
+    std::vector<int> out3(limit);
+    double views = bench::measure_ms([&] {
+        auto v = in | std::views::transform(triple) | std::views::filter(odd)
+            | std::views::transform(plus_one) | std::views::take(limit);
+        std::ranges::copy(v, out3.begin());
+    });
+    long long check_views = std::accumulate(out3.begin(), out3.end(), 0LL);
+
+    auto splittable = lazy::map(triple) | lazy::filter(odd) | lazy::map(plus_one);
+    long long par = 0;
+    double parallel = bench::measure_ms([&] {
+        par = lazy::par_reduce(in, splittable, 0LL, [](long long a, long long b) { return a + b; });
+    });
+
+    auto chunked = lazy::filter(odd) | lazy::chunk<int, 8>()
+        | lazy::map([](std::span<const int> c) { return c.size(); });
+    std::array<size_t, 2> sizes{};
+    lazy::into(std::span<const int>(in.data(), 20), chunked, std::span<size_t>(sizes));
+
+    long long with_init = lazy::par_reduce(std::vector<int>{1, 2, 3, 4}, lazy::map([](int x) { return x; }), 100LL,
+        [](long long a, long long b) { return a + b; }, 4);
+
+    std::cout << "n = " << n << ", take(" << limit << ")" << std::endl;
+    std::cout << "fused pipeline:        " << fused << " ms (checksum " << check_fused << ")" << std::endl;
+    std::cout << "chained std::transform: " << chained << " ms (checksum " << check_chained << ")" << std::endl;
+    std::cout << "std::views:            " << views << " ms (checksum " << check_views << ")" << std::endl;
+    std::cout << "fused par_reduce (no take): " << parallel << " ms (sum " << par << ")" << std::endl;
+    std::cout << "chunk<8> over 10 odd numbers: " << sizes[0] << " + " << sizes[1] << std::endl;
+    std::cout << "par_reduce({1, 2, 3, 4}, init 100, 4 threads): " << with_init << " (expect 110)" << std::endl;
+}
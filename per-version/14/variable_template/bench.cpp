@@ -0,0 +1,55 @@
+#include "bench.hpp"
+
+template<class T>
+constexpr T pi = T(3.1415926535897932385L);  // variable template
+
+template<class T>
+T pi2 = T(3.1415926535897932385L);
+
+template<class T>
+T circular_area(T r)
+{
+    return pi<T> * r * r;
+}
+
+template<class T>
+T circular_area_mutable(T r)
+{
+    return pi2<T> * r * r; // pi2 isn't constexpr, so it's a load every time
+}
+
+struct S {
+    S(bool b) : b_(b) {}
+    int maybe_expensive(int a) { return a * a; } // no sleep here
+    bool b_;
+};
+
+template<class T>
+int myvar = 1 + T(true).maybe_expensive(3);
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "14/variable_template");
+
+    runner.run("circular_area<double> (constexpr pi)", [](std::uint64_t n) {
+        double r = 1;
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(r);
+            bench::do_not_optimize(circular_area(r));
+        }
+    });
+    runner.run("circular_area<double> (mutable pi2)", [](std::uint64_t n) {
+        double r = 1;
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(r);
+            bench::do_not_optimize(circular_area_mutable(r));
+        }
+    });
+    runner.run("myvar<S> read", [](std::uint64_t n) {
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc += myvar<S>;
+            bench::do_not_optimize(acc);
+        }
+    });
+    return runner.finish();
+}
@@ -24,19 +24,36 @@ int main() {
     int n = 3;
     std::any a = n;
     
+#if __cpp_exceptions
     try {
         std::cout << std::any_cast<double>(a) << std::endl;
     } catch (std::bad_any_cast e) {
         std::cout << "Exception with `double`: " << e.what() << std::endl;
     }
+#else
+    // without exceptions a failed any_cast<T>(a) aborts, the pointer form returns nullptr
+    if (const double* d = std::any_cast<double>(&a)) {
+        std::cout << *d << std::endl;
+    } else {
+        std::cout << "No `double` in there" << std::endl;
+    }
+#endif
 
     a = "hello"; // we can assign a value of totally different type
                  // to std::any, no problem at all
+#if __cpp_exceptions
     try {
         std::cout << std::any_cast<char*>(a) << std::endl;
     } catch (std::bad_any_cast e) {
         std::cout << "Exception with `char*`: " << e.what() << std::endl;
     }
+#else
+    if (char* const* p = std::any_cast<char*>(&a)) {
+        std::cout << *p << std::endl;
+    } else {
+        std::cout << "No `char*` in there" << std::endl;
+    }
+#endif
 
 #if __cpp_rtti
     std::cout << "a's type is: " << a.type().name() << std::endl;
@@ -0,0 +1,95 @@
+#include <any>
+#include <string>
+
+#include "bench.hpp"
+
+// Copies and casts of std::any holding types that fit its small buffer (int
+// and the 8-byte S8) vs. types that don't, which cost an allocation on every
+// copy. libstdc++'s buffer is a single pointer, so S from any.cpp (16 bytes)
+// already lands on the heap.
+struct S8 {
+    S8(int x, float y) : x_(x), y_(y) {}
+    int x_;
+    float y_;
+};
+
+struct S {
+    S(int x, double y) : x_(x), y_(y) {}
+    int x_;
+    double y_;
+};
+
+struct Big {
+    char payload[64] = {};
+};
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "17/any");
+
+    std::any small = 3;
+    std::any s8 = S8(1, 2.3f);
+    std::any s = S(1, 2.3);
+    std::any big = Big{};
+    std::any str = std::string("hello, this is too long for SSO");
+
+    runner.run("copy/int", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::any a2 = small;
+            bench::do_not_optimize(a2);
+        }
+    });
+    runner.run("copy/S8", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::any a2 = s8;
+            bench::do_not_optimize(a2);
+        }
+    });
+    runner.run("copy/S (heap)", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::any a2 = s;
+            bench::do_not_optimize(a2);
+        }
+    });
+    runner.run("copy/Big (heap)", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::any a2 = big;
+            bench::do_not_optimize(a2);
+        }
+    });
+    runner.run("copy/std::string (heap)", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::any a2 = str;
+            bench::do_not_optimize(a2);
+        }
+    });
+    runner.run("any_cast<int>* hit", [&](std::uint64_t n) {
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(small);
+            acc += *std::any_cast<int>(&small);
+        }
+        bench::do_not_optimize(acc);
+    });
+    runner.run("any_cast<double>* miss", [&](std::uint64_t n) {
+        int misses = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(small);
+            misses += std::any_cast<double>(&small) == nullptr;
+        }
+        bench::do_not_optimize(misses);
+    });
+#if __cpp_exceptions
+    runner.run("any_cast<double> miss, throwing", [&](std::uint64_t n) {
+        int misses = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            try {
+                bench::do_not_optimize(std::any_cast<double>(small));
+            } catch(const std::bad_any_cast&) {
+                misses++;
+            }
+        }
+        bench::do_not_optimize(misses);
+    });
+#endif
+    return runner.finish();
+}
@@ -0,0 +1,32 @@
+#include <string>
+
+#include "bench.hpp"
+
+// The replace chain from ex1.cpp. Under C++17 the chained calls are
+// sequenced left to right; the cost should not depend on the standard.
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "17/eval_order");
+
+    const std::string original = "but I have heard it works even if you don't believe in it";
+    runner.run("chained replace", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::string s = original;
+            s.replace(0, 4, "")
+                .replace(
+                    s.find("even"), 4, "only"
+                )
+                .replace(s.find(" don't"), 6, "");
+            bench::do_not_optimize(s.data());
+        }
+    });
+    runner.run("separate statements", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::string s = original;
+            s.replace(0, 4, "");
+            s.replace(s.find("even"), 4, "only");
+            s.replace(s.find(" don't"), 6, "");
+            bench::do_not_optimize(s.data());
+        }
+    });
+    return runner.finish();
+}
@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <execution>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include "bench.hpp"
+
+// Sum of squares as in ex.cpp. The example locks a mutex under par_unseq,
+// which is not allowed (and may deadlock), so here it runs under plain
+// par, next to the sequential loop and a lock-free transform_reduce.
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "17/execution_policy");
+
+    std::vector<int> v(1 << 20);
+    std::iota(v.begin(), v.end(), 0);
+
+    runner.run("seq loop", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            long long sum = 0;
+            for(int x : v) sum += (long long)x * x;
+            bench::do_not_optimize(sum);
+        }
+    });
+    runner.run("par for_each + mutex", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            long long sum = 0;
+            std::mutex m;
+            std::for_each(std::execution::par, std::begin(v), std::end(v), [&](int x) {
+                std::lock_guard<std::mutex> lock{m};
+                sum += (long long)x * x;
+            });
+            bench::do_not_optimize(sum);
+        }
+    });
+    runner.run("par_unseq transform_reduce", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            long long sum = std::transform_reduce(std::execution::par_unseq, v.begin(), v.end(),
+                0LL, std::plus<>(), [](int x) { return (long long)x * x; });
+            bench::do_not_optimize(sum);
+        }
+    });
+    return runner.finish();
+}
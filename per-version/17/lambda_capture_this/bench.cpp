@@ -0,0 +1,51 @@
+#include <future>
+#include <vector>
+
+#include "bench.hpp"
+
+// Work from ex.cpp, made heavier to copy so that the difference between
+// capturing `*this` (a copy per task) and `this` (a pointer) is visible.
+class Work {
+    std::vector<int> values_;
+public:
+    Work() : values_(256, 42) {}
+
+    std::future<int> spawn_copy() {
+        return std::async(std::launch::deferred, [=, *this]() -> int {
+            return values_[0];
+        });
+    }
+    std::future<int> spawn() { // the one from ex.cpp
+        return std::async([=, *this]() -> int {
+            return values_[0];
+        });
+    }
+    std::future<int> spawn_ref() {
+        return std::async(std::launch::deferred, [this]() -> int {
+            return values_[0];
+        });
+    }
+};
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "17/lambda_capture_this");
+
+    Work w;
+    // deferred, so the thread start-up doesn't drown the capture cost
+    runner.run("async deferred [*this]", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(w.spawn_copy().get());
+        }
+    });
+    runner.run("async deferred [this]", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(w.spawn_ref().get());
+        }
+    });
+    runner.run("async default policy [*this]", [&](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(w.spawn().get());
+        }
+    });
+    return runner.finish();
+}
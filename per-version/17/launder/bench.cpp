@@ -0,0 +1,55 @@
+#include <new>
+
+#include "bench.hpp"
+
+// devirtualization.cpp without the printing: every call replaces the object
+// with one of the other type, so the call must go through std::launder and
+// can't be devirtualized; compared with an ordinary virtual call and a
+// direct (devirtualized) one.
+struct A {
+    virtual int f();
+    virtual int g() { return 1; }
+};
+
+struct B : A {
+    virtual int f() {
+        new (this) A; return 1;
+    }
+    virtual int g() { return 2; }
+};
+
+int A::f() {
+    new (this) B; return 2;
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "17/launder");
+
+    runner.run("laundered f() flipping A<->B", [](std::uint64_t n) {
+        A a;
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc += std::launder(&a)->f();
+        }
+        bench::do_not_optimize(acc);
+    });
+    runner.run("virtual g() through pointer", [](std::uint64_t n) {
+        B b;
+        A* p = &b;
+        bench::do_not_optimize(p);
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc += p->g();
+        }
+        bench::do_not_optimize(acc);
+    });
+    runner.run("direct a.g() (devirtualized)", [](std::uint64_t n) {
+        A a;
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc += a.g();
+            bench::do_not_optimize(acc);
+        }
+    });
+    return runner.finish();
+}
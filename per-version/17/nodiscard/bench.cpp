@@ -0,0 +1,62 @@
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "result.hpp"
+
+// [[nodiscard]] itself has no runtime cost; what matters on the hot path is
+// how the failure gets reported. Returning Result<int> from result.hpp vs.
+// throwing on bad input.
+struct [[nodiscard]] A {
+    A(int arg) : a(arg) {}
+    int a;
+};
+
+std::pair<int, A> retpairwithA(int x) {
+    return {x, A(x + 1)};
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "17/nodiscard");
+
+    runner.run("retpairwithA", [](std::uint64_t n) {
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            auto [x, a] = retpairwithA(int(i));
+            acc += x + a.a;
+            bench::do_not_optimize(acc);
+        }
+    });
+
+    for(int fail_percent : {0, 1, 50}) {
+        std::vector<std::string> inputs;
+        for(int i = 0; i < 1000; i++) {
+            inputs.push_back(i % 100 < fail_percent ? "x" + std::to_string(i) : std::to_string(i));
+        }
+        std::string suffix = "/" + std::to_string(fail_percent) + "% bad";
+        runner.run("Result<int>" + suffix, [&](std::uint64_t n) {
+            long long acc = 0;
+            for(std::uint64_t i = 0; i < n; i++) {
+                auto r = parse_int(inputs[i % inputs.size()]);
+                acc += r ? r.value() : -1;
+            }
+            bench::do_not_optimize(acc);
+        });
+#if __cpp_exceptions
+        runner.run("exception" + suffix, [&](std::uint64_t n) {
+            long long acc = 0;
+            for(std::uint64_t i = 0; i < n; i++) {
+                try {
+                    acc += parse_int_or_throw(inputs[i % inputs.size()]);
+                } catch(const std::system_error&) {
+                    acc -= 1;
+                }
+            }
+            bench::do_not_optimize(acc);
+        });
+#endif
+    }
+    return runner.finish();
+}
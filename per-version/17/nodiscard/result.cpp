@@ -0,0 +1,73 @@
+#include <any>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "bench.hpp"
+#include "result.hpp"
+
+// Result<T> from result.hpp in use: any_cast and integer parsing that report
+// failure through the return value, timed against throwing. -DRESULT_ONLY
+// leaves the throwing loop out even when exceptions are on, so bench.sh can
+// compare code size of the same source with and without -fno-exceptions.
+
+struct [[nodiscard]] A {
+    A(int arg) : a(arg) {}
+    int a;
+};
+
+Pair<int, A> retpairwithA() {
+    return {3, A(4)};
+}
+
+// any_cast without bad_any_cast
+template<typename T>
+Result<T> try_any_cast(const std::any& a) {
+    if(const T* p = std::any_cast<T>(&a)) {
+        return *p;
+    }
+    return std::errc::invalid_argument;
+}
+
+int main(int argc, char** argv) {
+    // retpairwithA(); // gives a warning now
+    // parse_int("3"); // so does this
+    auto [x, a] = retpairwithA();
+    (void) try_any_cast<double>(std::any(3)); // explicitly discarding, no warning
+    std::cout << "pair: " << x << ", " << a.a << "; any_cast<double>(3): "
+        << try_any_cast<double>(std::any(3)).error().message() << std::endl;
+
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    for(int fail_per_mille : {0, 10, 500}) {
+        std::vector<std::string> inputs;
+        for(std::size_t i = 0; i < n; i++) {
+            bool bad = int(i * 7919 % 1000) < fail_per_mille;
+            inputs.push_back(bad ? "12x" + std::to_string(i) : std::to_string(i));
+        }
+
+        long long sum = 0, errors = 0;
+        double with_result = bench::measure_ms([&] {
+            for(auto& s : inputs) {
+                if(auto r = parse_int(s)) sum += r.value(); else errors++;
+            }
+        });
+        std::cout << fail_per_mille / 10.0 << "% failures: Result " << with_result << " ms";
+
+#if __cpp_exceptions && !defined(RESULT_ONLY)
+        long long sum2 = 0, errors2 = 0;
+        double with_exceptions = bench::measure_ms([&] {
+            for(auto& s : inputs) {
+                try {
+                    sum2 += parse_int_or_throw(s);
+                } catch(const std::system_error&) {
+                    errors2++;
+                }
+            }
+        });
+        std::cout << ", exceptions " << with_exceptions << " ms (sum " << sum2 << ", " << errors2 << " errors)";
+#endif
+        std::cout << "; Result sum " << sum << ", " << errors << " errors" << std::endl;
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef CPPAWEEK_NODISCARD_RESULT_HPP
+#define CPPAWEEK_NODISCARD_RESULT_HPP
+
+#include <cassert>
+#include <charconv>
+#include <new>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// A value-or-std::error_code result for hot paths that can't (or shouldn't)
+// throw. The type itself is [[nodiscard]], so unlike retpairwithA() in
+// example.cpp the warning doesn't depend on the function being annotated,
+// and Pair/Tuple below keep it when results are bundled together.
+// Builds with -std=c++17 and -fno-exceptions; result.cpp and bench.cpp
+// measure it, see bench.sh for the size and speed comparison.
+
+namespace detail {
+
+// Storage for Result<T>. When T is trivially copyable the defaulted special
+// members are trivial too, so Result<T> is returned in registers; otherwise
+// they construct, assign and destroy the value only while there is one.
+template<typename T, bool = std::is_trivially_copyable_v<T>>
+struct ResultStorage {
+    explicit ResultStorage(std::error_code err) : err_(err) {}
+
+    union {
+        T value_;
+    };
+    std::error_code err_;
+};
+
+template<typename T>
+struct ResultStorage<T, false> {
+    explicit ResultStorage(std::error_code err) : err_(err) {}
+    ResultStorage(const ResultStorage& o) : err_(o.err_) {
+        if(!err_) new (&value_) T(o.value_);
+    }
+    ResultStorage(ResultStorage&& o) noexcept(std::is_nothrow_move_constructible_v<T>) : err_(o.err_) {
+        if(!err_) new (&value_) T(std::move(o.value_));
+    }
+    ResultStorage& operator= (const ResultStorage& o) {
+        if(this != &o) assign(o);
+        return *this;
+    }
+    ResultStorage& operator= (ResultStorage&& o) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                          std::is_nothrow_move_assignable_v<T>) {
+        if(this != &o) assign(std::move(o));
+        return *this;
+    }
+    ~ResultStorage() {
+        if(!err_) value_.~T();
+    }
+
+    union {
+        T value_;
+    };
+    std::error_code err_;
+
+private:
+    template<typename Other>
+    void assign(Other&& o) {
+        if(!err_ && !o.err_) {
+            value_ = std::forward<Other>(o).value_;
+            return;
+        }
+        if(!err_) value_.~T();
+        err_ = o.err_ ? o.err_ : std::make_error_code(std::errc::operation_canceled); // if T's constructor throws
+        if(!o.err_) {
+            new (&value_) T(std::forward<Other>(o).value_);
+            err_ = o.err_;
+        }
+    }
+};
+
+} // namespace detail
+
+template<typename T>
+class [[nodiscard]] Result : detail::ResultStorage<T> {
+    using Storage = detail::ResultStorage<T>;
+
+public:
+    Result(T value) : Storage(std::error_code()) { new (&this->value_) T(std::move(value)); }
+    // A zero error_code means "no error", which would leave ok() true with no
+    // value; that's a caller bug, caught in debug builds and reported as
+    // invalid_argument otherwise.
+    Result(std::error_code err) : Storage(err ? err : std::make_error_code(std::errc::invalid_argument)) {
+        assert(err && "Result needs a non-zero error_code");
+    }
+    Result(std::errc err) : Result(std::make_error_code(err)) {}
+
+    bool ok() const { return !this->err_; }
+    explicit operator bool() const { return ok(); }
+    std::error_code error() const { return this->err_; }
+
+    // precondition: ok()
+    T& value() & { return this->value_; }
+    const T& value() const& { return this->value_; }
+    T&& value() && { return std::move(this->value_); }
+    T value_or(T other) const { return ok() ? this->value_ : other; }
+};
+
+// For functions that can only fail.
+using Status = Result<std::monostate>;
+
+inline Status ok_status() { return Status(std::monostate{}); }
+
+// std::pair/std::tuple that keep the discard warning.
+template<typename A, typename B>
+struct [[nodiscard]] Pair : std::pair<A, B> {
+    using std::pair<A, B>::pair;
+};
+
+template<typename A, typename B>
+Pair(A, B) -> Pair<A, B>;
+
+template<typename... Ts>
+struct [[nodiscard]] Tuple : std::tuple<Ts...> {
+    using std::tuple<Ts...>::tuple;
+};
+
+template<typename... Ts>
+Tuple(Ts...) -> Tuple<Ts...>;
+
+static_assert(std::is_trivially_copyable_v<Result<int>>);
+static_assert(std::is_trivially_copyable_v<Result<std::string_view>>);
+static_assert(!std::is_trivially_copyable_v<Result<std::string>>);
+static_assert(std::is_nothrow_move_constructible_v<Result<std::string>>);
+
+// The hot path both result.cpp and bench.cpp measure.
+inline Result<int> parse_int(std::string_view s) {
+    int v = 0;
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+    if(ec != std::errc()) return ec;
+    if(ptr != s.data() + s.size()) return std::errc::invalid_argument;
+    return v;
+}
+
+#if __cpp_exceptions
+inline int parse_int_or_throw(std::string_view s) {
+    auto r = parse_int(s);
+    if(!r) throw std::system_error(r.error());
+    return r.value();
+}
+#endif
+
+#endif
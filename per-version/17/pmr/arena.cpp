@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+// Request-scoped arena for the containers from the other examples
+// (Foo/Bar from 20/no_unique_address, T from 20/init_in_range_for and the
+// result of Mapper from 11/type_alias). Allocation is a pointer bump,
+// deallocation does nothing and reset() hands everything back at once at
+// the end of a request -- while keeping the chunks for the next one,
+// which std::pmr::monotonic_buffer_resource::release() doesn't.
+
+class Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(std::size_t chunk_size = 64 * 1024,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : chunk_size_(chunk_size), upstream_(upstream) {}
+    Arena(const Arena&) = delete;
+    Arena& operator= (const Arena&) = delete;
+    ~Arena() {
+        for(auto& c : chunks_) upstream_->deallocate(c.base, c.size, alignof(std::max_align_t));
+    }
+
+    // Everything allocated so far is gone; the memory stays with the arena.
+    void reset() {
+        current_ = 0;
+        if(!chunks_.empty()) {
+            ptr_ = chunks_[0].base;
+            end_ = ptr_ + chunks_[0].size;
+        }
+    }
+
+private:
+    struct Chunk {
+        std::byte* base;
+        std::size_t size;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        for(;;) {
+            std::byte* p = reinterpret_cast<std::byte*>(
+                (reinterpret_cast<std::uintptr_t>(ptr_) + align - 1) & ~(std::uintptr_t(align) - 1));
+            if(ptr_ && p + bytes <= end_) {
+                ptr_ = p + bytes;
+                return p;
+            }
+            next_chunk(bytes + align);
+        }
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void next_chunk(std::size_t at_least) {
+        if(!chunks_.empty() && current_ + 1 < chunks_.size() && chunks_[current_ + 1].size >= at_least) {
+            ++current_;
+        } else {
+            std::size_t size = std::max(chunk_size_, at_least);
+            auto* base = static_cast<std::byte*>(upstream_->allocate(size, alignof(std::max_align_t)));
+            current_ = chunks_.empty() ? 0 : current_ + 1;
+            chunks_.insert(chunks_.begin() + current_, Chunk{base, size});
+        }
+        ptr_ = chunks_[current_].base;
+        end_ = ptr_ + chunks_[current_].size;
+    }
+
+    std::size_t chunk_size_;
+    std::pmr::memory_resource* upstream_;
+    std::vector<Chunk> chunks_;
+    std::size_t current_ = 0;
+    std::byte* ptr_ = nullptr;
+    std::byte* end_ = nullptr;
+};
+
+// One arena per thread, created on first use and kept for the thread's
+// lifetime, so a request never has to go to the global heap for it.
+Arena& request_arena() {
+    thread_local Arena arena;
+    return arena;
+}
+
+// Allocator-aware versions of the example types: same members, plus an
+// allocator parameter that defaults to what the originals use.
+template<class Reactor, class Alloc = std::allocator<int>>
+class Foo {
+public:
+    explicit Foo(const Alloc& a = Alloc()) : v(a) {}
+    std::vector<int, Alloc> v;
+    [[no_unique_address]] Reactor reactor_;
+
+    void add(int i) {
+        v.push_back(i);
+        reactor_(i);
+    }
+};
+
+template<class Reactor, class Alloc = std::allocator<int>>
+class Bar {
+public:
+    explicit Bar(const Alloc& a = Alloc()) : v(a) {}
+    std::vector<int, Alloc> v;
+    Reactor reactor_;
+
+    void add(int i) {
+        v.push_back(i);
+        reactor_(i);
+    }
+};
+
+template<class Alloc = std::allocator<int>>
+class T {
+    std::vector<int, Alloc> data_;
+public:
+    T(std::vector<int, Alloc> data) : data_(std::move(data)) {}
+    std::vector<int, Alloc>& items() { return data_; }
+};
+
+template<typename Item, typename ItemTransformed,
+template <typename> typename Container>
+using Mapper = std::function<Container<ItemTransformed>
+    (Container<Item>, std::function<Item(ItemTransformed)>)
+>;
+
+struct Summer {
+    long long sum = 0;
+    void operator() (int a) { sum += a; }
+};
+
+// One "request": build a few of the containers above, do some work, drop them.
+template<template <typename> typename Container, typename Alloc>
+long long handle_request(int id, const Alloc& alloc) {
+    Foo<Summer, Alloc> foo(alloc);
+    Bar<Summer, Alloc> bar(alloc);
+    for(int i = 0; i < 64; i++) {
+        foo.add(id + i);
+        bar.add(id - i);
+    }
+
+    std::vector<int, Alloc> seed(alloc);
+    for(int i = 0; i < 32; i++) seed.push_back(i * id);
+    T<Alloc> t(std::move(seed));
+
+    Mapper<int, int, Container> const mapper = [](auto v, auto f) {
+        Container<int> res(v.get_allocator());
+        res.reserve(v.size());
+        std::transform(v.begin(), v.end(), std::back_inserter(res), f);
+        return res;
+    };
+    long long acc = foo.reactor_.sum + bar.reactor_.sum;
+    for(int round = 0; round < 8; round++) {
+        Container<int> in(t.items().begin(), t.items().end(), alloc);
+        for(auto x : mapper(std::move(in), [round](int c) { return c + round; })) {
+            acc += x;
+        }
+    }
+    return acc;
+}
+
+// Forwards to another resource and adds up the time spent in it. Only used
+// for the profiling pass, the clock reads would skew the throughput numbers.
+class TimedResource : public std::pmr::memory_resource {
+public:
+    explicit TimedResource(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+    long long ns = 0;
+    long long calls = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        auto start = std::chrono::steady_clock::now();
+        void* p = upstream_->allocate(bytes, align);
+        add(start);
+        return p;
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        auto start = std::chrono::steady_clock::now();
+        upstream_->deallocate(p, bytes, align);
+        add(start);
+    }
+    void add(std::chrono::steady_clock::time_point start) {
+        ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        calls++;
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+};
+
+template<typename F>
+void throughput(const char* name, unsigned threads, int requests, F&& one_request) {
+    std::atomic<long long> checksum{0};
+    double secs = bench::measure_ms([&] {
+        std::vector<std::thread> workers;
+        for(unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                long long local = 0;
+                for(int r = 0; r < requests; r++) {
+                    local += one_request(int(t) * requests + r);
+                }
+                checksum += local;
+            });
+        }
+        for(auto& w : workers) w.join();
+    }) / 1e3;
+    std::cout << "  " << name << ": " << threads * requests / secs / 1e3
+        << " k requests/s (checksum " << checksum.load() << ")" << std::endl;
+}
+
+template<typename T_>
+using pmr_vector = std::pmr::vector<T_>;
+
+int main(int argc, char** argv) {
+    int requests = argc > 1 ? std::atoi(argv[1]) : 200'000;
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<unsigned> thread_counts{1u, hw, 2 * hw};
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+    for(unsigned threads : thread_counts) {
+        std::cout << threads << " thread(s), " << requests << " requests each:" << std::endl;
+        throughput("std::allocator    ", threads, requests, [](int id) {
+            // every allocation is freed one by one by the destructors
+            return handle_request<std::vector>(id, std::allocator<int>{});
+        });
+        throughput("thread-local arena", threads, requests, [](int id) {
+            Arena& arena = request_arena();
+            long long r = handle_request<pmr_vector>(id, std::pmr::polymorphic_allocator<int>(&arena));
+            arena.reset();
+            return r;
+        });
+    }
+
+    std::cout << "Time spent inside the allocator, per request:" << std::endl;
+    int profiled = std::min(requests, 20'000);
+    {
+        // new_delete_resource is what std::allocator ends up calling as well
+        TimedResource heap(std::pmr::new_delete_resource());
+        for(int r = 0; r < profiled; r++) {
+            handle_request<pmr_vector>(r, std::pmr::polymorphic_allocator<int>(&heap));
+        }
+        std::cout << "  global heap: " << double(heap.ns) / profiled << " ns in "
+            << double(heap.calls) / profiled << " calls" << std::endl;
+    }
+    {
+        Arena arena;
+        TimedResource timed(&arena);
+        long long reset_ns = 0;
+        for(int r = 0; r < profiled; r++) {
+            handle_request<pmr_vector>(r, std::pmr::polymorphic_allocator<int>(&timed));
+            auto start = std::chrono::steady_clock::now();
+            arena.reset();
+            reset_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+        std::cout << "  arena:       " << double(timed.ns + reset_ns) / profiled << " ns in "
+            << double(timed.calls) / profiled << " calls + reset()" << std::endl;
+    }
+}
@@ -0,0 +1,51 @@
+#include <memory_resource>
+#include <vector>
+
+#include "bench.hpp"
+
+// A request-sized burst of small vectors (like the ones arena.cpp builds)
+// from the global heap vs. the standard pmr resources. Arena itself lives
+// in arena.cpp, which has its own multi-threaded request loop.
+template<typename Vector, typename... Alloc>
+long long burst(const Alloc&... alloc) {
+    long long acc = 0;
+    std::vector<Vector> all;
+    all.reserve(32);
+    for(int i = 0; i < 32; i++) {
+        all.emplace_back(alloc...);
+        for(int j = 0; j < 48; j++) all.back().push_back(i + j);
+    }
+    for(auto& v : all) acc += v.back();
+    return acc;
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "17/pmr");
+
+    runner.run("std::allocator", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(burst<std::vector<int>>());
+        }
+    });
+    runner.run("pmr new_delete_resource", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::pmr::polymorphic_allocator<int> a(std::pmr::new_delete_resource());
+            bench::do_not_optimize(burst<std::pmr::vector<int>>(a));
+        }
+    });
+    runner.run("pmr monotonic_buffer_resource", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::pmr::monotonic_buffer_resource arena(16 * 1024);
+            std::pmr::polymorphic_allocator<int> a(&arena);
+            bench::do_not_optimize(burst<std::pmr::vector<int>>(a));
+        }
+    });
+    runner.run("pmr unsynchronized_pool_resource", [](std::uint64_t n) {
+        std::pmr::unsynchronized_pool_resource pool;
+        for(std::uint64_t i = 0; i < n; i++) {
+            std::pmr::polymorphic_allocator<int> a(&pool);
+            bench::do_not_optimize(burst<std::pmr::vector<int>>(a));
+        }
+    });
+    return runner.finish();
+}
@@ -0,0 +1,70 @@
+#include <set>
+#include <string>
+
+#include "bench.hpp"
+
+// Constraints are checked at compile time only: the constrained `foo` from
+// ex4.cpp and `willfoo` from ex2.cpp should run exactly as fast as their
+// unconstrained twins. fast_search.cpp has the container-specific searches.
+template<typename T, typename R>
+concept NiceSearchableContainer = requires (T x, R z) {
+    std::is_integral<T>::value;
+    requires requires (R q) {
+        q.find(z);
+    };
+    R::npos;
+};
+
+template<typename T, typename R>
+requires NiceSearchableContainer<T, R>
+bool foo(T x, const R& y) {
+    return y.find("baz") != R::npos;
+}
+
+template<typename T, typename R>
+bool foo_unconstrained(T x, const R& y) {
+    return y.find("baz") != R::npos;
+}
+
+template<typename T>
+concept Fooable = requires (T x) {
+    { x.foo() };
+};
+
+struct DoesFoo {
+    int n = 0;
+    int foo() { return ++n; }
+};
+
+template<Fooable T>
+int willfoo(T& x) {
+    return x.foo();
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "20/concepts");
+
+    for(std::size_t size : {64, 4096}) {
+        std::string s(size, 'a');
+        std::string suffix = "/" + std::to_string(size);
+        runner.run("constrained foo" + suffix, [&](std::uint64_t n) {
+            for(std::uint64_t i = 0; i < n; i++) {
+                bench::do_not_optimize(s);
+                bench::do_not_optimize(foo(1, s));
+            }
+        });
+        runner.run("unconstrained foo" + suffix, [&](std::uint64_t n) {
+            for(std::uint64_t i = 0; i < n; i++) {
+                bench::do_not_optimize(s);
+                bench::do_not_optimize(foo_unconstrained(1, s));
+            }
+        });
+    }
+    runner.run("willfoo", [](std::uint64_t n) {
+        DoesFoo d;
+        for(std::uint64_t i = 0; i < n; i++) {
+            bench::do_not_optimize(willfoo(d));
+        }
+    });
+    return runner.finish();
+}
@@ -0,0 +1,198 @@
+// Compile-time stress corpus for the constraint shapes from ex2.cpp, ex3.cpp
+// and ex4.cpp. Pick one shape and one way of spelling the constraint:
+//   -DPATTERN=1  conjunction of traits + compound requirement (Conc, ex3.cpp)
+//   -DPATTERN=2  expression + nested type requirement (Fooable/HasFT, ex2.cpp)
+//   -DPATTERN=3  nested `requires requires` (NiceSearchableContainer, ex4.cpp)
+//   -DSTYLE=0    unconstrained, the baseline the other styles are compared to
+//   -DSTYLE=1    concepts
+//   -DSTYLE=2    expression SFINAE in the return type
+//   -DSTYLE=3    std::enable_if on a detection trait
+//   -DN=<count>  how many distinct types get checked against the constraint
+// Every type W<I> is distinct, so nothing can be served from the compiler's
+// satisfaction/instantiation caches. See run.sh for the measuring part.
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#ifndef PATTERN
+#define PATTERN 1
+#endif
+#ifndef STYLE
+#define STYLE 1
+#endif
+#ifndef N
+#define N 2000
+#endif
+
+template<std::size_t I>
+struct W {
+    struct Foo {
+        void shout() {}
+    };
+    Foo mem;
+    static constexpr std::size_t npos = std::size_t(-1);
+
+    void foo() {}
+    std::size_t find(const char*) const { return I; }
+    int operator+ (int x) const { return x + int(I); }
+};
+
+#if PATTERN == 1
+
+#if STYLE == 0
+template<typename T, typename R>
+int check(T x, R y) { return *y + x; }
+#elif STYLE == 1
+template<typename A, typename B, typename C, typename D>
+concept ThreeIntegralsAndSecondPointer =
+    std::is_integral<A>::value && std::is_pointer<B>::value &&
+    std::is_integral<C>::value && std::is_integral<D>::value;
+
+template<typename T, typename R>
+concept Conc = requires (T x, T y, R z) {
+    {*z + (x - y)} -> ThreeIntegralsAndSecondPointer<R, T, T>;
+};
+
+template<typename T, typename R>
+requires Conc<T, R>
+int check(T x, R y) { return *y + x; }
+#elif STYLE == 2
+template<typename T, typename R>
+auto check(T x, R y) -> std::enable_if_t<
+    std::is_integral<decltype(*y + (x - x))>::value && std::is_pointer<R>::value &&
+    std::is_integral<T>::value, int> {
+    return *y + x;
+}
+#else
+template<typename T, typename R, typename = void>
+struct ConcTrait : std::false_type {};
+
+template<typename T, typename R>
+struct ConcTrait<T, R, std::void_t<decltype(*std::declval<R>() + (std::declval<T>() - std::declval<T>()))>>
+    : std::bool_constant<
+        std::is_integral<decltype(*std::declval<R>() + (std::declval<T>() - std::declval<T>()))>::value &&
+        std::is_pointer<R>::value && std::is_integral<T>::value> {};
+
+template<typename T, typename R, std::enable_if_t<ConcTrait<T, R>::value, int> = 0>
+int check(T x, R y) { return *y + x; }
+#endif
+
+template<std::size_t I>
+int use() {
+    static W<I> w;
+    return check(int(I), &w);
+}
+
+#elif PATTERN == 2
+
+#if STYLE == 0
+template<typename T>
+int check(T x) {
+    x.foo();
+    typename T::Foo y = x.mem;
+    y.shout();
+    return 0;
+}
+#elif STYLE == 1
+template<typename T>
+concept Fooable = requires (T x) {
+    { x.foo() };
+};
+
+template<typename T>
+concept HasFT = requires (T x) {
+    typename T::Foo;
+};
+
+template<typename T>
+requires Fooable<T> && HasFT<T>
+int check(T x) {
+    x.foo();
+    typename T::Foo y = x.mem;
+    y.shout();
+    return 0;
+}
+#elif STYLE == 2
+template<typename T>
+auto check(T x) -> decltype(x.foo(), std::declval<typename T::Foo>(), int()) {
+    x.foo();
+    typename T::Foo y = x.mem;
+    y.shout();
+    return 0;
+}
+#else
+template<typename T, typename = void>
+struct Fooable : std::false_type {};
+
+template<typename T>
+struct Fooable<T, std::void_t<decltype(std::declval<T&>().foo())>> : std::true_type {};
+
+template<typename T, typename = void>
+struct HasFT : std::false_type {};
+
+template<typename T>
+struct HasFT<T, std::void_t<typename T::Foo>> : std::true_type {};
+
+template<typename T, std::enable_if_t<Fooable<T>::value && HasFT<T>::value, int> = 0>
+int check(T x) {
+    x.foo();
+    typename T::Foo y = x.mem;
+    y.shout();
+    return 0;
+}
+#endif
+
+template<std::size_t I>
+int use() {
+    return check(W<I>{});
+}
+
+#else
+
+#if STYLE == 0
+template<typename R>
+int check(const R& y) { return y.find("baz") != R::npos; }
+#elif STYLE == 1
+template<typename R>
+concept NiceSearchableContainer = requires (R z) {
+    requires requires (R q) {
+        q.find("baz");
+    };
+    R::npos;
+};
+
+template<typename R>
+requires NiceSearchableContainer<R>
+int check(const R& y) { return y.find("baz") != R::npos; }
+#elif STYLE == 2
+template<typename R>
+auto check(const R& y) -> decltype(y.find("baz"), R::npos, int()) {
+    return y.find("baz") != R::npos;
+}
+#else
+template<typename R, typename = void>
+struct NiceSearchableContainer : std::false_type {};
+
+template<typename R>
+struct NiceSearchableContainer<R,
+    std::void_t<decltype(std::declval<const R&>().find("baz")), decltype(R::npos)>> : std::true_type {};
+
+template<typename R, std::enable_if_t<NiceSearchableContainer<R>::value, int> = 0>
+int check(const R& y) { return y.find("baz") != R::npos; }
+#endif
+
+template<std::size_t I>
+int use() {
+    return check(W<I>{});
+}
+
+#endif
+
+template<std::size_t... I>
+int use_all(std::index_sequence<I...>) {
+    return (use<I>() + ...);
+}
+
+int main() {
+    return use_all(std::make_index_sequence<N>{}) == 42;
+}
@@ -0,0 +1,151 @@
+#!/usr/bin/env bash
+# Compiles constraints.cpp for every (compiler, pattern, style) combination,
+# REPS times each (default 5), and prints per combination:
+#   - the median wall time, with the min..max spread over the repetitions;
+#   - the median CPU time of the frontend's template instantiation and
+#     constraint satisfaction phases, taken from the reports below, so the
+#     constraint cost isn't judged on a total that includes codegen;
+#   - peak memory;
+#   - the differences from the unconstrained baseline (STYLE=0) of the same
+#     pattern. The baseline already pays for W<I>, use<I> and the codegen, so
+#     the difference is what the constraint itself costs. A time difference
+#     smaller than the spread is noise.
+# Detailed per-phase breakdowns of the last repetition are left in $OUT:
+# gcc's -ftime-report as .txt, clang's -ftime-trace as .json (open in
+# chrome://tracing or speedscope).
+#
+# usage: [REPS=5] ./run.sh [N] [compilers...]     e.g. ./run.sh 4000 g++-12 clang++-15
+set -u
+
+HERE="$(cd "$(dirname "$0")" && pwd)"
+N="${1:-2000}"
+shift || true
+COMPILERS=("$@")
+if [ ${#COMPILERS[@]} -eq 0 ]; then
+    COMPILERS=(g++ clang++)
+fi
+REPS="${REPS:-5}"
+[ "$REPS" -ge 3 ] 2> /dev/null || { echo "REPS must be at least 3" >&2; exit 1; }
+OUT="${OUT:-$(mktemp -d)}"
+PATTERNS=(conc fooable nested)
+STYLES=(none concepts sfinae enable_if)
+TIME_BIN=/usr/bin/time
+
+median() {
+    printf "%s\n" "$@" | sort -g | awk '{ v[NR] = $1 } END {
+        if(NR == 0) print "n/a"; else if(NR % 2) print v[(NR + 1) / 2]; else print (v[NR / 2] + v[NR / 2 + 1]) / 2 }'
+}
+
+# "<min>..<max>" of the arguments
+spread() {
+    printf "%s\n" "$@" | sort -g | awk 'NR == 1 { lo = $1 } { hi = $1 } END { printf "%.2f..%.2f", lo, hi }'
+}
+
+# signed difference a - b, or n/a if either side is missing
+delta() {
+    awk -v a="$1" -v b="$2" -v f="$3" 'BEGIN {
+        if(a == "" || b == "" || a == "n/a" || b == "n/a") print "n/a"; else printf f, a - b }'
+}
+
+# CPU seconds spent instantiating templates and checking constraints
+instantiation_secs() {
+    local report="$1"
+    if [ -f "$report.json" ]; then
+        # clang: the "Total Instantiate*" summary events, durations in us
+        grep -o '{[^{}]*"name":"Total Instantiate[A-Za-z]*"[^{}]*' "$report.json" |
+            grep -o '"dur":[0-9]*' | awk -F: '{ t += $2 } END { printf "%.2f", t / 1e6 }'
+    else
+        # gcc: usr + sys of the matching -ftime-report rows
+        awk -F: '/^ (template instantiation|constraint satisfaction) / {
+                n = 0
+                for(i = 1; i <= split($2, f, " "); i++) if(f[i] ~ /^[0-9.]+$/ && n++ < 2) t += f[i]
+            } END { printf "%.2f", t }' "$report.txt"
+    fi
+}
+
+echo "N = $N, $REPS repetitions, reports in $OUT"
+printf "%-12s %-8s %-10s %9s %12s %9s %11s %12s %13s %14s\n" compiler pattern style \
+    "time [s]" "min..max" "inst [s]" "peak [MiB]" "vs none [s]" "inst vs none" "vs none [MiB]"
+
+for cxx in "${COMPILERS[@]}"; do
+    if ! command -v "$cxx" > /dev/null; then
+        echo "$cxx: not found, skipping" >&2
+        continue
+    fi
+    is_clang=0
+    "$cxx" --version | grep -q clang && is_clang=1
+
+    for p in 1 2 3; do
+        base_secs=""
+        base_inst=""
+        base_mem=""
+        for s in 0 1 2 3; do
+            name="$(basename "$cxx")-${PATTERNS[p-1]}-${STYLES[s]}"
+            flags=(-std=c++20 -O0 -c -DPATTERN=$p -DSTYLE=$s -DN=$N
+                "$HERE/constraints.cpp" -o "$OUT/$name.o")
+            if [ $is_clang -eq 1 ]; then
+                # use_all is a fold over N calls, clang caps those at 256 by default
+                flags+=(-ftime-trace -fbracket-depth=$((N + 64)))
+            else
+                flags+=(-ftime-report)
+            fi
+
+            times=()
+            insts=()
+            mems=()
+            failed=0
+            for ((r = 0; r < REPS; r++)); do
+                rm -f "$OUT/$name.rss" "$OUT/$name.json"
+                start=$(date +%s%N)
+                if [ -x "$TIME_BIN" ]; then
+                    "$TIME_BIN" -f "%M" -o "$OUT/$name.rss" "$cxx" "${flags[@]}" 2> "$OUT/$name.txt"
+                else
+                    "$cxx" "${flags[@]}" 2> "$OUT/$name.txt"
+                fi
+                status=$?
+                end=$(date +%s%N)
+                if [ $status -ne 0 ]; then
+                    failed=1
+                    break
+                fi
+                [ -f "$OUT/$name.o.json" ] && mv "$OUT/$name.o.json" "$OUT/$name.json"
+
+                if [ -f "$OUT/$name.rss" ]; then
+                    mems+=("$(awk '{ printf "%.1f", $1 / 1024 }' "$OUT/$name.rss")")
+                else
+                    # no GNU time around: fall back to gcc's own GC memory total
+                    mem=$(awk '/^ TOTAL/ { v = $NF; sub(/[kM]$/, "", v);
+                        printf "%.1f", ($NF ~ /M$/) ? v : v / 1024 }' "$OUT/$name.txt")
+                    [ -n "$mem" ] && mems+=("$mem")
+                fi
+                times+=("$(awk -v a="$start" -v b="$end" 'BEGIN { printf "%.3f", (b - a) / 1e9 }')")
+                insts+=("$(instantiation_secs "$OUT/$name")")
+            done
+
+            if [ $failed -ne 0 ]; then
+                printf "%-12s %-8s %-10s %9s\n" "$cxx" "${PATTERNS[p-1]}" "${STYLES[s]}" FAILED
+                continue
+            fi
+
+            secs=$(median "${times[@]}")
+            inst=$(median "${insts[@]}")
+            mem="n/a"
+            [ ${#mems[@]} -gt 0 ] && mem=$(median "${mems[@]}")
+            range=$(spread "${times[@]}")
+            if [ $s -eq 0 ]; then
+                base_secs="$secs"
+                base_inst="$inst"
+                base_mem="$mem"
+                dsecs="-"
+                dinst="-"
+                dmem="-"
+            else
+                dsecs=$(delta "$secs" "$base_secs" "%+.2f")
+                dinst=$(delta "$inst" "$base_inst" "%+.2f")
+                dmem=$(delta "$mem" "$base_mem" "%+.1f")
+            fi
+            printf "%-12s %-8s %-10s %9.2f %12s %9s %11s %12s %13s %14s\n" "$cxx" "${PATTERNS[p-1]}" \
+                "${STYLES[s]}" "$secs" "$range" "$inst" "$mem" "$dsecs" "$dinst" "$dmem"
+        done
+    done
+done
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <ranges>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "bench.hpp"
+
+// Same shape as in ex4.cpp -- `foo` just calls whatever `find` the container has.
+template<typename T, typename R>
+concept NiceSearchableContainer = requires (T x, R z) {
+    std::is_integral<T>::value;
+    requires requires (R q) {
+        q.find(z);
+    };
+    R::npos;
+};
+
+template<typename T, typename R>
+requires NiceSearchableContainer<T, R>
+bool foo(T x, R y) {
+    return y.find("baz") != R::npos;
+}
+
+// Categories we know how to search better than a generic `find`.
+template<typename R>
+concept ContiguousChars = std::ranges::contiguous_range<R> &&
+    std::same_as<std::ranges::range_value_t<R>, char>;
+
+template<typename R>
+concept TransparentOrdered = requires {
+    typename R::key_compare::is_transparent;
+};
+
+template<typename R>
+concept TransparentUnordered = requires {
+    typename R::hasher::is_transparent;
+    typename R::key_equal::is_transparent;
+};
+
+// Sortedness is a runtime property, so the caller has to vouch for it.
+template<std::ranges::contiguous_range R>
+requires std::totally_ordered<std::ranges::range_value_t<R>>
+struct Sorted {
+    const R& range;
+};
+
+template<typename R>
+Sorted(const R&) -> Sorted<R>;
+
+// (1) substring search: compare first and last byte of the needle across
+// 16 candidate positions at once, only memcmp where both match
+inline const char* simd_search(const char* hay, size_t n, const char* needle, size_t k) {
+    if(k == 0) return hay;
+    if(k > n) return nullptr;
+    if(k == 1) return static_cast<const char*>(std::memchr(hay, needle[0], n));
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[k - 1]);
+    for( ; i + 16 + k - 1 <= n; i += 16) {
+        __m128i bf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+        __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + k - 1));
+        unsigned mask = _mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, last)));
+        while(mask) {
+            unsigned bit = __builtin_ctz(mask);
+            if(std::memcmp(hay + i + bit + 1, needle + 1, k - 2) == 0) {
+                return hay + i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for( ; i + k <= n; ++i) { // tail (or everything, without SSE2)
+        if(hay[i] == needle[0] && hay[i + k - 1] == needle[k - 1] &&
+           std::memcmp(hay + i + 1, needle + 1, k - 2) == 0) {
+            return hay + i;
+        }
+    }
+    return nullptr;
+}
+
+// (2) branchless lower bound: the loop body is a conditional move, no
+// unpredictable jump on the comparison result
+template<typename T, typename K>
+const T* branchless_lower_bound(const T* base, size_t n, const K& key) {
+    if(n == 0) return base;
+    while(n > 1) {
+        size_t half = n / 2;
+        base = (base[half - 1] < key) ? base + half : base;
+        n -= half;
+    }
+    return base + (*base < key);
+}
+
+// Fallback for everything below that has no better path: the container's
+// own find, as in `foo`. Unconstrained, so any constrained overload wins.
+template<typename R, typename K>
+bool fast_find(const R& c, const K& key) {
+    if constexpr (requires { R::npos; }) {
+        return c.find(key) != R::npos;
+    } else {
+        return c.find(key) != c.end();
+    }
+}
+
+template<ContiguousChars R, typename K>
+requires std::convertible_to<const K&, std::string_view>
+bool fast_find(const R& hay, const K& key) {
+    std::string_view needle = key;
+    return simd_search(std::ranges::data(hay), std::ranges::size(hay),
+        needle.data(), needle.size()) != nullptr;
+}
+
+template<typename R, typename K>
+requires TransparentOrdered<R> || TransparentUnordered<R>
+bool fast_find(const R& c, const K& key) {
+    return c.find(key) != c.end(); // no temporary key_type constructed
+}
+
+template<typename R, typename K>
+bool fast_find(Sorted<R> s, const K& key) {
+    auto* b = std::ranges::data(s.range);
+    auto n = std::ranges::size(s.range);
+    auto* it = branchless_lower_bound(b, n, key);
+    return it != b + n && !(key < *it);
+}
+
+// `foo`, but routed through the category-specific search; containers
+// without one still end up in their own find via the fallback
+template<typename T, typename R>
+requires std::is_integral<T>::value
+bool fastfoo(T x, const R& y) {
+    return fast_find(y, "baz");
+}
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator() (std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+
+int main() {
+    std::vector<std::string> words{"bar", "baz", "foo"};
+    std::cout << fastfoo(1, std::string("bar")) << fastfoo(1, std::string("foobaz"))
+        << fastfoo(1, std::set<std::string>{"baz"}) << fastfoo(1, std::set<std::string, std::less<>>{"bar"})
+        << fastfoo(1, Sorted{words}) << std::endl;
+    volatile bool sink = false;
+
+    // All 'a' is the worst case for std::string::find: the needle starts with
+    // 'a' too, so its first-character scan stops at every position. Random
+    // text is what it usually sees.
+    std::mt19937 rng(42);
+    const char alphabet[] = "abcdefghijklmnopqrstuvwxyz ";
+    std::cout << "substring search (needle at the very end):" << std::endl;
+    for(bool adversarial : {true, false}) {
+        for(size_t n : {1u << 10, 1u << 16, 1u << 20}) {
+            std::string hay(n, 'a');
+            if(!adversarial) {
+                for(auto& c : hay) c = alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+            hay.replace(n - 6, 6, "abcbaz");
+            int reps = (1 << 24) / n;
+            double plain = bench::measure_ns([&] { sink = hay.find("abcbaz") != std::string::npos; }, reps);
+            double fast = bench::measure_ns([&] { sink = fast_find(hay, "abcbaz"); }, reps);
+            std::cout << "  " << (adversarial ? "all 'a' (adversarial)" : "random text          ")
+                << " n = " << n << ": std::string::find " << plain
+                << " ns, simd_search " << fast << " ns" << std::endl;
+        }
+    }
+
+    std::cout << "associative lookup by const char*:" << std::endl;
+    for(size_t n : {1u << 6, 1u << 12, 1u << 16}) {
+        std::set<std::string> plainset;
+        std::set<std::string, std::less<>> tset;
+        std::unordered_set<std::string, StringHash, std::equal_to<>> tuset;
+        for(size_t i = 0; i < n; i++) {
+            auto key = "some rather long key number " + std::to_string(i);
+            plainset.insert(key); tset.insert(key); tuset.insert(key);
+        }
+        const char* q = "some rather long key number 17";
+        int reps = 1 << 18;
+        double plain = bench::measure_ns([&] { sink = plainset.find(q) != plainset.end(); }, reps);
+        double ordered = bench::measure_ns([&] { sink = fast_find(tset, q); }, reps);
+        double unordered = bench::measure_ns([&] { sink = fast_find(tuset, q); }, reps);
+        std::cout << "  n = " << n << ": std::set::find " << plain << " ns, transparent set "
+            << ordered << " ns, transparent unordered_set " << unordered << " ns" << std::endl;
+    }
+
+    std::cout << "sorted contiguous search:" << std::endl;
+    for(size_t n : {1u << 6, 1u << 12, 1u << 20}) {
+        std::vector<int> v(n);
+        for(size_t i = 0; i < n; i++) v[i] = 2 * i;
+        int reps = 1 << 16;
+        int key = 0;
+        double plain = bench::measure_ns([&] {
+            sink = std::find(v.begin(), v.end(), key) != v.end();
+            key = (key + 7919) % (2 * n);
+        }, reps);
+        double lower = bench::measure_ns([&] {
+            sink = std::binary_search(v.begin(), v.end(), key);
+            key = (key + 7919) % (2 * n);
+        }, reps);
+        double fast = bench::measure_ns([&] {
+            sink = fast_find(Sorted{v}, key);
+            key = (key + 7919) % (2 * n);
+        }, reps);
+        std::cout << "  n = " << n << ": std::find " << plain << " ns, std::binary_search "
+            << lower << " ns, branchless " << fast << " ns" << std::endl;
+    }
+}
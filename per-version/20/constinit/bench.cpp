@@ -0,0 +1,37 @@
+#include <cstdlib>
+
+#include "bench.hpp"
+
+// A constinit thread_local (ex.cpp's `z`) is plain TLS; a thread_local with
+// a dynamic initializer gets a "has this been initialized yet?" check (a
+// call through the TLS wrapper) on every access.
+constinit thread_local int z = 3 + 4;
+
+int dynamic_init() { return std::atoi("7"); }
+thread_local int w = dynamic_init();
+
+constinit int x = 2 + 3;
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "20/constinit");
+
+    runner.run("constinit thread_local ++", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            z++;
+            bench::clobber_memory();
+        }
+    });
+    runner.run("dynamic thread_local ++", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            w++;
+            bench::clobber_memory();
+        }
+    });
+    runner.run("constinit global ++", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            x++;
+            bench::clobber_memory();
+        }
+    });
+    return runner.finish();
+}
@@ -0,0 +1,73 @@
+#include <coroutine>
+
+#include "bench.hpp"
+
+// MyGenerator from ex.cpp with the logging stripped out: cost of one
+// resume/yield round trip, against computing the squares in a plain loop.
+class MyGenerator {
+public:
+    struct MyPromise;
+    using promise_type = MyPromise;
+
+    MyGenerator(std::coroutine_handle<MyPromise> h) : coro_(h) {}
+    MyGenerator(const MyGenerator&) = delete;
+    ~MyGenerator() {
+        if(coro_) coro_.destroy();
+    }
+
+    int very_custom_value() {
+        return coro_.promise().val_ + 1;
+    }
+
+    bool very_custom_next() {
+        coro_.resume();
+        return !coro_.done();
+    }
+
+    struct MyPromise {
+        MyGenerator get_return_object() {
+            return MyGenerator{std::coroutine_handle<MyPromise>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() { return {}; }
+        std::suspend_always yield_value(int x) { val_ = x; return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void unhandled_exception() {}
+        int val_ = 0;
+    };
+
+private:
+    std::coroutine_handle<MyPromise> coro_;
+};
+
+MyGenerator allSquares() {
+    for(int i = 1; ; ++i) {
+        co_yield (i * i);
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "20/coroutines");
+
+    runner.run("generator next + value", [](std::uint64_t n) {
+        MyGenerator gen = allSquares();
+        int acc = 0;
+        for(std::uint64_t i = 0; i < n && gen.very_custom_next(); i++) {
+            acc += gen.very_custom_value();
+        }
+        bench::do_not_optimize(acc);
+    });
+    runner.run("create + destroy generator", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            MyGenerator gen = allSquares();
+            bench::do_not_optimize(gen);
+        }
+    });
+    runner.run("plain loop", [](std::uint64_t n) {
+        int acc = 0;
+        for(std::uint64_t i = 1; i <= n; i++) {
+            acc += int(i * i) + 1;
+            bench::do_not_optimize(acc);
+        }
+    });
+    return runner.finish();
+}
@@ -0,0 +1,483 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+// Bounded MPMC channel for coroutines. Values go through a lock-free ring
+// (Vyukov's bounded queue); a coroutine that finds the ring full (send) or
+// empty (receive) is parked in a waiter list and resumed on an Executor
+// thread by whoever frees a slot / publishes a value. Nothing ever sleeps
+// in the kernel: waiter lists are guarded by a spinlock held for a few
+// pointer swaps and idle executor threads just yield.
+
+class SpinLock {
+    std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+public:
+    void lock() {
+        while(flag_.test_and_set(std::memory_order_acquire)) {
+            while(flag_.test(std::memory_order_relaxed)) {}
+        }
+    }
+    void unlock() { flag_.clear(std::memory_order_release); }
+};
+
+class Executor {
+public:
+    explicit Executor(unsigned threads) {
+        for(unsigned i = 0; i < threads; i++) {
+            workers_.emplace_back([this] { run(); });
+        }
+    }
+    ~Executor() {
+        stop_ = true;
+        for(auto& w : workers_) w.join();
+    }
+
+    void post(std::coroutine_handle<> h) {
+        std::lock_guard<SpinLock> g{lock_};
+        queue_.push_back(h);
+    }
+
+private:
+    void run() {
+        while(!stop_.load(std::memory_order_relaxed)) {
+            std::coroutine_handle<> h;
+            {
+                std::lock_guard<SpinLock> g{lock_};
+                if(!queue_.empty()) {
+                    h = queue_.front();
+                    queue_.pop_front();
+                }
+            }
+            if(h) {
+                h.resume();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    SpinLock lock_;
+    std::deque<std::coroutine_handle<>> queue_;
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> workers_;
+};
+
+// Fire-and-forget coroutine, started by posting it to an Executor.
+struct Task {
+    struct promise_type {
+        Task get_return_object() {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    std::coroutine_handle<promise_type> h;
+};
+
+template<typename T>
+class Channel {
+    struct Waiter {
+        std::coroutine_handle<> h;
+        Waiter* next = nullptr;
+    };
+
+    struct WaitList {
+        SpinLock lock;
+        Waiter* head = nullptr;
+        Waiter* tail = nullptr;
+        std::atomic<std::size_t> count{0};
+
+        void push_back(Waiter* w) {
+            w->next = nullptr;
+            if(tail) tail->next = w; else head = w;
+            tail = w;
+        }
+        void push_front(Waiter* w) {
+            w->next = head;
+            head = w;
+            if(!tail) tail = w;
+        }
+        Waiter* pop() {
+            Waiter* w = head;
+            if(w) {
+                head = w->next;
+                if(!head) tail = nullptr;
+            }
+            return w;
+        }
+    };
+
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+
+public:
+    Channel(Executor& ex, std::size_t capacity) : ex_(ex) {
+        std::size_t cap = 2;
+        while(cap < capacity) cap *= 2;
+        mask_ = cap - 1;
+        cells_ = std::make_unique<Cell[]>(cap);
+        for(std::size_t i = 0; i < cap; i++) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    struct SendAwaiter : Waiter {
+        Channel& ch;
+        T value;
+
+        bool await_ready() {
+            if(!ch.try_push(value)) return false;
+            ch.wake_receiver();
+            return true;
+        }
+        bool await_suspend(std::coroutine_handle<> h) {
+            this->h = h;
+            auto& wl = ch.senders_;
+            wl.lock.lock();
+            wl.count.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(ch.try_push(value)) {
+                wl.count.fetch_sub(1);
+                wl.lock.unlock();
+                ch.wake_receiver();
+                return false;
+            }
+            wl.push_back(this);
+            wl.lock.unlock(); // may be resumed from now on, don't touch `this`
+            return true;
+        }
+        void await_resume() {}
+    };
+
+    struct ReceiveAwaiter : Waiter {
+        Channel& ch;
+        std::optional<T> slot;
+
+        bool await_ready() {
+            T v;
+            if(!ch.try_pop(v)) return false;
+            slot = std::move(v);
+            ch.wake_sender();
+            return true;
+        }
+        bool await_suspend(std::coroutine_handle<> h) {
+            this->h = h;
+            auto& wl = ch.receivers_;
+            wl.lock.lock();
+            wl.count.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            T v;
+            if(ch.try_pop(v)) {
+                wl.count.fetch_sub(1);
+                wl.lock.unlock();
+                slot = std::move(v);
+                ch.wake_sender();
+                return false;
+            }
+            if(ch.closed_.load()) {
+                wl.count.fetch_sub(1);
+                wl.lock.unlock();
+                return false;
+            }
+            wl.push_back(this);
+            wl.lock.unlock();
+            return true;
+        }
+        std::optional<T> await_resume() { return std::move(slot); }
+    };
+
+    SendAwaiter send(T v) { return SendAwaiter{{}, *this, std::move(v)}; }
+
+    // nullopt once the channel is closed and drained
+    ReceiveAwaiter receive() { return ReceiveAwaiter{{}, *this, std::nullopt}; }
+
+    // Only call once every send has completed; parked receivers get nullopt.
+    void close() {
+        closed_.store(true);
+        receivers_.lock.lock();
+        Waiter* all = receivers_.head;
+        receivers_.head = receivers_.tail = nullptr;
+        receivers_.count.store(0);
+        receivers_.lock.unlock();
+        while(all) {
+            auto* w = static_cast<ReceiveAwaiter*>(all);
+            all = all->next;
+            T v;
+            if(try_pop(v)) w->slot = std::move(v);
+            ex_.post(w->h);
+        }
+    }
+
+private:
+    bool try_push(T& v) {
+        std::size_t pos = enqueue_.load(std::memory_order_relaxed);
+        Cell* c;
+        for(;;) {
+            c = &cells_[pos & mask_];
+            std::size_t seq = c->seq.load(std::memory_order_acquire);
+            auto dif = std::intptr_t(seq) - std::intptr_t(pos);
+            if(dif == 0) {
+                if(enqueue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if(dif < 0) {
+                return false;
+            } else {
+                pos = enqueue_.load(std::memory_order_relaxed);
+            }
+        }
+        c->value = std::move(v);
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& v) {
+        std::size_t pos = dequeue_.load(std::memory_order_relaxed);
+        Cell* c;
+        for(;;) {
+            c = &cells_[pos & mask_];
+            std::size_t seq = c->seq.load(std::memory_order_acquire);
+            auto dif = std::intptr_t(seq) - std::intptr_t(pos + 1);
+            if(dif == 0) {
+                if(dequeue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if(dif < 0) {
+                return false;
+            } else {
+                pos = dequeue_.load(std::memory_order_relaxed);
+            }
+        }
+        v = std::move(c->value);
+        c->seq.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    // A value was just published: hand it to a parked receiver, if any.
+    void wake_receiver() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(receivers_.count.load(std::memory_order_relaxed) == 0) return;
+        receivers_.lock.lock();
+        auto* w = static_cast<ReceiveAwaiter*>(receivers_.pop());
+        if(w) receivers_.count.fetch_sub(1);
+        receivers_.lock.unlock();
+        if(!w) return;
+
+        T v;
+        if(try_pop(v)) {
+            w->slot = std::move(v);
+            ex_.post(w->h);
+            wake_sender();
+            return;
+        }
+        // someone on the fast path beat us to it, park the receiver again
+        receivers_.lock.lock();
+        receivers_.count.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(try_pop(v)) {
+            receivers_.count.fetch_sub(1);
+            receivers_.lock.unlock();
+            w->slot = std::move(v);
+            ex_.post(w->h);
+            wake_sender();
+            return;
+        }
+        if(closed_.load()) {
+            receivers_.count.fetch_sub(1);
+            receivers_.lock.unlock();
+            ex_.post(w->h);
+            return;
+        }
+        receivers_.push_front(w);
+        receivers_.lock.unlock();
+    }
+
+    // A slot was just freed: let a parked sender put its value there.
+    void wake_sender() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(senders_.count.load(std::memory_order_relaxed) == 0) return;
+        senders_.lock.lock();
+        auto* w = static_cast<SendAwaiter*>(senders_.pop());
+        if(w) senders_.count.fetch_sub(1);
+        senders_.lock.unlock();
+        if(!w) return;
+
+        if(try_push(w->value)) {
+            ex_.post(w->h);
+            wake_receiver();
+            return;
+        }
+        senders_.lock.lock();
+        senders_.count.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(try_push(w->value)) {
+            senders_.count.fetch_sub(1);
+            senders_.lock.unlock();
+            ex_.post(w->h);
+            wake_receiver();
+            return;
+        }
+        senders_.push_front(w);
+        senders_.lock.unlock();
+    }
+
+    Executor& ex_;
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> enqueue_{0};
+    alignas(64) std::atomic<std::size_t> dequeue_{0};
+    alignas(64) WaitList senders_;
+    alignas(64) WaitList receivers_;
+    std::atomic<bool> closed_{false};
+};
+
+// The baseline: a bounded queue with a mutex and two condition variables.
+template<typename T>
+class BlockingQueue {
+public:
+    explicit BlockingQueue(std::size_t capacity) : cap_(capacity) {}
+
+    void send(T v) {
+        std::unique_lock<std::mutex> l{m_};
+        not_full_.wait(l, [&] { return q_.size() < cap_; });
+        q_.push_back(std::move(v));
+        not_empty_.notify_one();
+    }
+    std::optional<T> receive() {
+        std::unique_lock<std::mutex> l{m_};
+        not_empty_.wait(l, [&] { return !q_.empty() || closed_; });
+        if(q_.empty()) return std::nullopt;
+        T v = std::move(q_.front());
+        q_.pop_front();
+        not_full_.notify_one();
+        return v;
+    }
+    void close() {
+        std::lock_guard<std::mutex> l{m_};
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+private:
+    std::mutex m_;
+    std::condition_variable not_full_, not_empty_;
+    std::deque<T> q_;
+    std::size_t cap_;
+    bool closed_ = false;
+};
+
+using Clock = std::chrono::steady_clock;
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+}
+
+struct Stats {
+    std::mutex m;
+    std::vector<std::int64_t> latencies; // every 16th message per consumer
+
+    void merge(std::vector<std::int64_t>& local) {
+        std::lock_guard<std::mutex> l{m};
+        latencies.insert(latencies.end(), local.begin(), local.end());
+    }
+};
+
+// Like allSquares in ex.cpp, but pushing into a channel instead of being pulled.
+Task producer(Channel<std::int64_t>& ch, long count,
+             std::atomic<int>& producers_left, std::atomic<int>& running) {
+    for(long i = 1; i <= count; ++i) {
+        co_await ch.send(now_ns()); // payload is the send time, for latency
+    }
+    if(producers_left.fetch_sub(1) == 1) {
+        ch.close();
+    }
+    running.fetch_sub(1);
+}
+
+Task consumer(Channel<std::int64_t>& ch, Stats& stats, std::atomic<int>& running) {
+    std::vector<std::int64_t> local;
+    long n = 0;
+    while(auto v = co_await ch.receive()) {
+        if(n++ % 16 == 0) local.push_back(now_ns() - *v);
+    }
+    stats.merge(local);
+    running.fetch_sub(1);
+}
+
+void print(const char* name, long total, double secs, Stats& stats) {
+    auto& l = stats.latencies;
+    std::sort(l.begin(), l.end());
+    std::cout << "  " << name << ": " << total / secs / 1e6 << " M msg/s";
+    if(!l.empty()) {
+        std::cout << ", latency p50 " << l[l.size() / 2] << " ns, p99 " << l[l.size() * 99 / 100] << " ns";
+    }
+    std::cout << std::endl;
+}
+
+void bench_channel(int producers, int consumers, long per_producer, std::size_t capacity) {
+    unsigned threads = std::max(1u, std::min(unsigned(producers + consumers),
+        std::thread::hardware_concurrency()));
+    Stats stats;
+    std::atomic<int> producers_left{producers};
+    std::atomic<int> running{producers + consumers};
+    double secs = bench::measure_ms([&] {
+        Executor ex(threads);
+        Channel<std::int64_t> ch(ex, capacity);
+        for(int c = 0; c < consumers; c++) ex.post(consumer(ch, stats, running).h);
+        for(int p = 0; p < producers; p++) ex.post(producer(ch, per_producer, producers_left, running).h);
+        while(running.load() > 0) std::this_thread::yield();
+    }) / 1e3;
+    print("coroutine channel", per_producer * producers, secs, stats);
+}
+
+void bench_blocking(int producers, int consumers, long per_producer, std::size_t capacity) {
+    Stats stats;
+    BlockingQueue<std::int64_t> q(capacity);
+    std::atomic<int> producers_left{producers};
+    double secs = bench::measure_ms([&] {
+        std::vector<std::thread> threads;
+        for(int c = 0; c < consumers; c++) {
+            threads.emplace_back([&] {
+                std::vector<std::int64_t> local;
+                long n = 0;
+                while(auto v = q.receive()) {
+                    if(n++ % 16 == 0) local.push_back(now_ns() - *v);
+                }
+                stats.merge(local);
+            });
+        }
+        for(int p = 0; p < producers; p++) {
+            threads.emplace_back([&] {
+                for(long i = 0; i < per_producer; i++) q.send(now_ns());
+                if(producers_left.fetch_sub(1) == 1) q.close();
+            });
+        }
+        for(auto& t : threads) t.join();
+    }) / 1e3;
+    print("mutex + condvar   ", per_producer * producers, secs, stats);
+}
+
+int main(int argc, char** argv) {
+    long total = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 2'000'000;
+    std::size_t capacity = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1024;
+    struct { int p, c; } topologies[] = {{1, 1}, {4, 1}, {4, 4}};
+    for(auto [p, c] : topologies) {
+        std::cout << p << ":" << c << " (" << total << " messages, capacity " << capacity << ")" << std::endl;
+        bench_channel(p, c, total / p, capacity);
+        bench_blocking(p, c, total / p, capacity);
+    }
+}
@@ -0,0 +1,54 @@
+#include <vector>
+
+#include "bench.hpp"
+
+// T and foo() from init.cpp: `for (auto t = foo(); auto& x : t.items())`
+// keeps the temporary alive safely; the price is whatever foo() costs,
+// here the copy T's constructor makes of its by-value argument.
+class T {
+    std::vector<int> data_;
+public:
+    T(std::vector<int> data) : data_(data) {}
+    std::vector<int>& items() { return data_; }
+};
+
+class TMove {
+    std::vector<int> data_;
+public:
+    TMove(std::vector<int> data) : data_(std::move(data)) {}
+    std::vector<int>& items() { return data_; }
+};
+
+T foo() {
+    std::vector<int> v{2,3,7};
+    return T(v);
+}
+
+TMove foo_move() {
+    std::vector<int> v{2,3,7};
+    return TMove(std::move(v));
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "20/init_in_range_for");
+
+    runner.run("init statement, copying T", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            int acc = 0;
+            for (auto t = foo(); auto& x : t.items()) {
+                acc += x;
+            }
+            bench::do_not_optimize(acc);
+        }
+    });
+    runner.run("init statement, moving T", [](std::uint64_t n) {
+        for(std::uint64_t i = 0; i < n; i++) {
+            int acc = 0;
+            for (auto t = foo_move(); auto& x : t.items()) {
+                acc += x;
+            }
+            bench::do_not_optimize(acc);
+        }
+    });
+    return runner.finish();
+}
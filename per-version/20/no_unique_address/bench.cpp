@@ -0,0 +1,72 @@
+#include <vector>
+
+#include "bench.hpp"
+
+// Reactor dispatch in Foo/Bar from ex.cpp with a reactor that doesn't print.
+// The add() path is the same; the difference is only in the object size,
+// which shows up once many of them are iterated.
+template<class Reactor>
+class Foo {
+public:
+    std::vector<int> v;
+    [[no_unique_address]] Reactor reactor_;
+
+    void add(int i) {
+        v.push_back(i);
+        reactor_(i);
+    }
+};
+
+template<class Reactor>
+class Bar {
+public:
+    std::vector<int> v;
+    Reactor reactor_;
+
+    void add(int i) {
+        v.push_back(i);
+        reactor_(i);
+    }
+};
+
+struct Checker {
+    void operator() (int a) {
+        if(a < 0) __builtin_trap();
+    }
+};
+
+template<typename C>
+void add_bench(bench::Runner& runner, const char* name) {
+    runner.run(name, [](std::uint64_t n) {
+        C c;
+        c.v.reserve(1024);
+        for(std::uint64_t i = 0; i < n; i++) {
+            if(c.v.size() == 1024) c.v.clear();
+            c.add(int(i & 0xffff));
+        }
+        bench::do_not_optimize(c.v.data());
+    });
+}
+
+template<typename C>
+void iterate_bench(bench::Runner& runner, const char* name) {
+    std::vector<C> all(1 << 16);
+    for(std::size_t i = 0; i < all.size(); i++) all[i].add(int(i));
+    runner.run(name, [&](std::uint64_t n) {
+        long long acc = 0;
+        for(std::uint64_t i = 0; i < n; i++) {
+            acc += all[(i * 40503) & (all.size() - 1)].v.size();
+        }
+        bench::do_not_optimize(acc);
+    });
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "20/no_unique_address");
+
+    add_bench<Foo<Checker>>(runner, "add/Foo<Checker>");
+    add_bench<Bar<Checker>>(runner, "add/Bar<Checker>");
+    iterate_bench<Foo<Checker>>(runner, "scattered size()/Foo<Checker>");
+    iterate_bench<Bar<Checker>>(runner, "scattered size()/Bar<Checker>");
+    return runner.finish();
+}
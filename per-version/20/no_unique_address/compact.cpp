@@ -0,0 +1,195 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "bench.hpp"
+
+// Foo<Reactor> from ex.cpp generalized: every customization point is a
+// policy and every policy is stored with `no_unique_address`, so stateless
+// ones cost nothing. On top of that size/capacity are SizeType (32 bits by
+// default) and up to InlineCap elements live inside the object itself.
+
+struct NoReactor {
+    void operator() (int) {}
+};
+
+// Growth policies saturate at the largest S instead of wrapping around,
+// which with a small SizeType would otherwise happen long before memory runs out.
+struct DoublingGrowth {
+    template<typename S>
+    S next(S cap, S needed) const {
+        constexpr S max = std::numeric_limits<S>::max();
+        S doubled = !cap ? S(4) : cap > max / 2 ? max : S(cap * 2);
+        return std::max<S>(needed, doubled);
+    }
+};
+
+struct AddFourGrowth { // for containers that never grow much
+    template<typename S>
+    S next(S cap, S needed) const {
+        constexpr S max = std::numeric_limits<S>::max();
+        return std::max<S>(needed, cap > max - 4 ? max : S(cap + 4));
+    }
+};
+
+template<typename T,
+         class Reactor = NoReactor,
+         std::size_t InlineCap = 0,
+         class SizeType = std::uint32_t,
+         class Growth = DoublingGrowth,
+         class Alloc = std::allocator<T>>
+class CompactVec {
+    static_assert(std::is_trivially_copyable<T>::value, "elements are moved with memcpy");
+    static_assert(std::is_unsigned<SizeType>::value);
+
+    static constexpr std::size_t inline_bytes = InlineCap * sizeof(T);
+    static constexpr std::size_t storage_bytes =
+        inline_bytes > sizeof(T*) ? inline_bytes : sizeof(T*);
+
+    union {
+        T* heap_;
+        alignas(T) unsigned char inline_[storage_bytes];
+    };
+    SizeType size_ = 0;
+    SizeType cap_ = InlineCap;
+    [[no_unique_address]] Alloc alloc_;
+    [[no_unique_address]] Growth growth_;
+
+public:
+    [[no_unique_address]] Reactor reactor_;
+
+    CompactVec() : heap_(nullptr) {}
+    CompactVec(const CompactVec&) = delete;
+    CompactVec& operator= (const CompactVec&) = delete;
+    CompactVec(CompactVec&& other) noexcept
+        : size_(other.size_), cap_(other.cap_), alloc_(other.alloc_),
+          growth_(other.growth_), reactor_(other.reactor_) {
+        std::memcpy(inline_, other.inline_, storage_bytes);
+        other.size_ = 0;
+        other.cap_ = InlineCap;
+    }
+    ~CompactVec() {
+        if(!is_inline()) {
+            std::allocator_traits<Alloc>::deallocate(alloc_, heap_, cap_);
+        }
+    }
+
+    bool is_inline() const { return cap_ <= InlineCap; }
+    T* data() { return is_inline() ? reinterpret_cast<T*>(inline_) : heap_; }
+    const T* data() const { return is_inline() ? reinterpret_cast<const T*>(inline_) : heap_; }
+    SizeType size() const { return size_; }
+    SizeType capacity() const { return cap_; }
+    static constexpr SizeType max_size() { return std::numeric_limits<SizeType>::max(); }
+    T* begin() { return data(); }
+    T* end() { return data() + size_; }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size_; }
+
+    void add(T x) {
+        if(size_ == cap_) {
+            if(size_ == max_size()) {
+#if __cpp_exceptions
+                throw std::length_error("CompactVec: SizeType is full");
+#else
+                std::abort();
+#endif
+            }
+            grow(growth_.next(cap_, SizeType(size_ + 1)));
+        }
+        data()[size_++] = x;
+        reactor_(x);
+    }
+
+private:
+    void grow(SizeType new_cap) {
+        T* fresh = std::allocator_traits<Alloc>::allocate(alloc_, new_cap);
+        if(size_) std::memcpy(fresh, data(), size_ * sizeof(T));
+        if(!is_inline()) {
+            std::allocator_traits<Alloc>::deallocate(alloc_, heap_, cap_);
+        }
+        heap_ = fresh;
+        cap_ = new_cap;
+    }
+};
+
+// The baseline: what ex.cpp's Foo/Bar look like without a logging reactor.
+template<class Reactor>
+struct Foo {
+    std::vector<int> v;
+    [[no_unique_address]] Reactor reactor_;
+    void add(int i) { v.push_back(i); reactor_(i); }
+    auto begin() const { return v.begin(); }
+    auto end() const { return v.end(); }
+};
+
+template<class Reactor>
+struct Bar {
+    std::vector<int> v;
+    Reactor reactor_;
+    void add(int i) { v.push_back(i); reactor_(i); }
+    auto begin() const { return v.begin(); }
+    auto end() const { return v.end(); }
+};
+
+class CountingReactor {
+    std::uint32_t n_ = 0;
+public:
+    void operator() (int) { n_++; }
+};
+
+template<typename C>
+void report(const char* name, std::size_t count) {
+    constexpr std::size_t line = 64;
+    std::cout << name << ": sizeof " << sizeof(C) << ", alignof " << alignof(C)
+        << ", " << line / sizeof(C) << " objects per cache line, "
+        << count * sizeof(C) / (1 << 20) << " MiB of headers for " << count << " objects" << std::endl;
+}
+
+template<typename C>
+void iterate(const char* name, std::size_t count, int per_object) {
+    std::vector<C> all(count);
+    for(std::size_t i = 0; i < count; i++) {
+        for(int j = 0; j < per_object; j++) {
+            all[i].add(int(i) + j);
+        }
+    }
+    long long sum = 0;
+    double ms = bench::measure_ms([&] {
+        for(int rep = 0; rep < 5; rep++) {
+            for(const auto& c : all) {
+                for(int x : c) sum += x;
+            }
+        }
+    });
+    std::cout << "  " << name << ": " << ms / 5 << " ms per pass (checksum " << sum << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    std::cout << "Footprint:" << std::endl;
+    report<Bar<NoReactor>>("Bar<NoReactor>", count);
+    report<Foo<NoReactor>>("Foo<NoReactor>", count);
+    report<Foo<CountingReactor>>("Foo<CountingReactor>", count);
+    report<CompactVec<int>>("CompactVec<int>", count);
+    report<CompactVec<int, NoReactor, 2>>("CompactVec<int, NoReactor, 2>", count);
+    report<CompactVec<int, NoReactor, 4>>("CompactVec<int, NoReactor, 4>", count);
+    report<CompactVec<int, CountingReactor, 2>>("CompactVec<int, CountingReactor, 2>", count);
+    report<CompactVec<int, NoReactor, 2, std::uint32_t, AddFourGrowth>>("CompactVec<..., AddFourGrowth>", count);
+
+    for(int per_object : {2, 4, 16}) {
+        std::cout << "Iterating " << count << " containers with " << per_object << " ints each:" << std::endl;
+        iterate<Bar<NoReactor>>("Bar<NoReactor>", count, per_object);
+        iterate<Foo<NoReactor>>("Foo<NoReactor>", count, per_object);
+        iterate<CompactVec<int>>("CompactVec<int>", count, per_object);
+        iterate<CompactVec<int, NoReactor, 2>>("CompactVec<int, NoReactor, 2>", count, per_object);
+        iterate<CompactVec<int, NoReactor, 4>>("CompactVec<int, NoReactor, 4>", count, per_object);
+    }
+}
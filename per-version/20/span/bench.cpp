@@ -0,0 +1,61 @@
+#include <span>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+// every_second from ex.cpp summing instead of printing, through std::span
+// and through a const std::vector& for comparison.
+template<typename T>
+long long every_second(std::span<T> s) {
+    long long sum = 0;
+    for(bool skip = false; auto& elem : s) {
+        if(!skip) {
+            sum += elem;
+        }
+        skip = !skip;
+    }
+    return sum;
+}
+
+template<typename T>
+long long every_second_vector(const std::vector<T>& s) {
+    long long sum = 0;
+    for(bool skip = false; auto& elem : s) {
+        if(!skip) {
+            sum += elem;
+        }
+        skip = !skip;
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    bench::Runner runner(argc, argv, "20/span");
+
+    for(std::size_t size : {16, 4096, 1 << 20}) {
+        std::vector<int> v(size, 3);
+        std::string s(size, 'c');
+        std::string suffix = "/" + std::to_string(size);
+
+        runner.run("span<const int>" + suffix, [&](std::uint64_t n) {
+            for(std::uint64_t i = 0; i < n; i++) {
+                bench::do_not_optimize(v.data());
+                bench::do_not_optimize(every_second<const int>(v));
+            }
+        });
+        runner.run("const vector<int>&" + suffix, [&](std::uint64_t n) {
+            for(std::uint64_t i = 0; i < n; i++) {
+                bench::do_not_optimize(v.data());
+                bench::do_not_optimize(every_second_vector(v));
+            }
+        });
+        runner.run("span<const char>" + suffix, [&](std::uint64_t n) {
+            for(std::uint64_t i = 0; i < n; i++) {
+                bench::do_not_optimize(s.data());
+                bench::do_not_optimize(every_second<const char>(s));
+            }
+        });
+    }
+    return runner.finish();
+}
@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cerrno>
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bench.hpp"
+
+// Read-only file mapped into memory and handed out as std::span<const T>
+// windows, so kernels like `every_second` from ex.cpp can run straight on
+// the file's pages instead of on a copy read into a vector.
+
+enum class Advice {
+    None,
+    Sequential, // MADV_SEQUENTIAL: aggressive readahead, drop pages behind us
+    HugePages,  // MADV_HUGEPAGE: fewer TLB misses (only where the fs supports it)
+};
+
+class MappedWindow {
+public:
+    MappedWindow() = default;
+    MappedWindow(void* base, std::size_t len, std::size_t skip)
+        : base_(base), len_(len), skip_(skip) {}
+    MappedWindow(MappedWindow&& o) noexcept
+        : base_(std::exchange(o.base_, nullptr)), len_(o.len_), skip_(o.skip_) {}
+    MappedWindow& operator= (MappedWindow&& o) noexcept {
+        std::swap(base_, o.base_);
+        std::swap(len_, o.len_);
+        std::swap(skip_, o.skip_);
+        return *this;
+    }
+    ~MappedWindow() {
+        if(base_) munmap(base_, len_);
+    }
+
+    // The typed view; throws if the window start isn't suitably aligned for T.
+    template<typename T>
+    std::span<const T> as() const {
+        static_assert(std::is_trivially_copyable<T>::value);
+        const char* p = static_cast<const char*>(base_) + skip_;
+        if(reinterpret_cast<std::uintptr_t>(p) % alignof(T) != 0) {
+            throw std::invalid_argument("mapped window is misaligned for the requested type");
+        }
+        return {reinterpret_cast<const T*>(p), (len_ - skip_) / sizeof(T)};
+    }
+
+private:
+    void* base_ = nullptr;
+    std::size_t len_ = 0;
+    std::size_t skip_ = 0;
+};
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if(fd_ < 0) {
+            throw std::system_error(errno, std::system_category(), "open " + path);
+        }
+        struct stat st;
+        if(fstat(fd_, &st) != 0) {
+            int err = errno;
+            ::close(fd_);
+            throw std::system_error(err, std::system_category(), "fstat " + path);
+        }
+        size_ = st.st_size;
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator= (const MappedFile&) = delete;
+    ~MappedFile() { ::close(fd_); }
+
+    std::size_t size() const { return size_; }
+
+    // Maps [offset, offset + len) of the file; `offset` need not be page aligned.
+    MappedWindow map(std::size_t offset, std::size_t len, Advice advice = Advice::None) const {
+        if(offset > size_) {
+            throw std::out_of_range("window starts past the end of the file");
+        }
+        len = std::min(len, size_ - offset);
+        static const std::size_t page = sysconf(_SC_PAGESIZE);
+        std::size_t start = offset - offset % page;
+        std::size_t skip = offset - start;
+        if(len == 0) return {};
+        void* base = mmap(nullptr, len + skip, PROT_READ, MAP_PRIVATE, fd_, start);
+        if(base == MAP_FAILED) {
+            throw std::system_error(errno, std::system_category(), "mmap");
+        }
+        switch(advice) {
+        case Advice::Sequential:
+            madvise(base, len + skip, MADV_SEQUENTIAL);
+            break;
+        case Advice::HugePages:
+#ifdef MADV_HUGEPAGE
+            madvise(base, len + skip, MADV_HUGEPAGE);
+#endif
+            break;
+        case Advice::None:
+            break;
+        }
+        return {base, len + skip, skip};
+    }
+
+private:
+    int fd_ = -1;
+    std::size_t size_ = 0;
+};
+
+// Minimal generator, same machinery as in coroutines/ex.cpp minus the logging.
+template<typename T>
+class Generator {
+public:
+    struct promise_type {
+        T value_;
+        std::exception_ptr error_;
+
+        Generator get_return_object() {
+            return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T v) { value_ = std::move(v); return {}; }
+        void return_void() {}
+        void unhandled_exception() { error_ = std::current_exception(); }
+    };
+
+    explicit Generator(std::coroutine_handle<promise_type> h) : coro_(h) {}
+    Generator(Generator&& o) noexcept : coro_(std::exchange(o.coro_, {})) {}
+    ~Generator() { if(coro_) coro_.destroy(); }
+
+    bool next() {
+        coro_.resume();
+        if(coro_.promise().error_) std::rethrow_exception(coro_.promise().error_);
+        return !coro_.done();
+    }
+    T& value() { return coro_.promise().value_; }
+
+private:
+    std::coroutine_handle<promise_type> coro_;
+};
+
+// Slides a window of `window_bytes` over the file, so only that much address
+// space is in use at once. Windows are cut on sizeof(T) boundaries; the
+// previous mapping is released when the consumer asks for the next one.
+// Windows smaller than one T (including 0) are rounded up to one T.
+template<typename T>
+Generator<std::span<const T>> windows(const MappedFile& file, std::size_t window_bytes,
+                                      Advice advice = Advice::Sequential) {
+    window_bytes = std::max(sizeof(T), window_bytes - window_bytes % sizeof(T));
+    for(std::size_t off = 0; off + sizeof(T) <= file.size(); off += window_bytes) {
+        MappedWindow w = file.map(off, window_bytes, advice);
+        co_yield w.as<T>();
+    }
+}
+
+// ex.cpp's every_second, summing instead of printing
+template<typename T>
+long long every_second(std::span<const T> s, bool& skip) {
+    long long sum = 0;
+    for(auto& elem : s) {
+        if(!skip) {
+            sum += elem;
+        }
+        skip = !skip;
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    std::size_t mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    std::string path = argc > 2 ? argv[2] : "/tmp/mmap_view_bench.bin";
+    std::size_t count = mib * (1 << 20) / sizeof(int);
+    {
+        std::vector<int> chunk(1 << 20);
+        std::ofstream out(path, std::ios::binary);
+        for(std::size_t written = 0; written < count; written += chunk.size()) {
+            for(std::size_t i = 0; i < chunk.size(); i++) chunk[i] = int((written + i) % 1000);
+            out.write(reinterpret_cast<const char*>(chunk.data()),
+                std::min(chunk.size(), count - written) * sizeof(int));
+        }
+    }
+
+    MappedFile file(path);
+    std::cout << "file: " << path << " (" << file.size() / (1 << 20) << " MiB)" << std::endl;
+
+    for(int rep = 0; rep < 2; rep++) {
+        long long sum1 = 0;
+        double read = bench::measure_ms([&] {
+            std::ifstream in(path, std::ios::binary);
+            std::vector<int> v(count);
+            in.read(reinterpret_cast<char*>(v.data()), count * sizeof(int));
+            bool skip = false;
+            sum1 = every_second<int>(v, skip);
+        });
+
+        long long sum2 = 0;
+        double whole = bench::measure_ms([&] {
+            MappedWindow w = file.map(0, file.size(), Advice::Sequential);
+            bool skip = false;
+            sum2 = every_second(w.as<int>(), skip);
+        });
+
+        long long sum3 = 0;
+        double sliding = bench::measure_ms([&] {
+            auto gen = windows<int>(file, 64 << 20);
+            bool skip = false;
+            while(gen.next()) {
+                sum3 += every_second(gen.value(), skip);
+            }
+        });
+
+        long long sum4 = 0;
+        double huge = bench::measure_ms([&] {
+            MappedWindow w = file.map(0, file.size(), Advice::HugePages);
+            bool skip = false;
+            sum4 = every_second(w.as<int>(), skip);
+        });
+
+        std::cout << "pass " << rep << ":" << std::endl
+            << "  ifstream into vector:    " << read << " ms (sum " << sum1 << ")" << std::endl
+            << "  mmap whole, sequential:  " << whole << " ms (sum " << sum2 << ")" << std::endl
+            << "  mmap 64 MiB windows:     " << sliding << " ms (sum " << sum3 << ")" << std::endl
+            << "  mmap whole, hugepage:    " << huge << " ms (sum " << sum4 << ")" << std::endl;
+    }
+
+    try {
+        file.map(1, 16).as<int>(); // oops, not on an int boundary
+    } catch(const std::invalid_argument& e) {
+        std::cout << "misaligned view rejected: " << e.what() << std::endl;
+    }
+    std::remove(path.c_str());
+}